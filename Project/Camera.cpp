@@ -23,11 +23,19 @@ Camera* Camera::GetSingleton()
 void Camera::SetCenter(const Vector2& center)
 {
 	m_Center = center;
+	++m_Version;
+}
+
+void Camera::SetScreenSize(const Vector2& screenSize)
+{
+	m_ScreenSize = screenSize;
+	++m_Version;
 }
 
 void Camera::AddZoom(float value)
 {
 	m_Zoom = max(m_Zoom + value, 0.1f);
+	++m_Version;
 }
 
 void Camera::Move(int x, int y)
@@ -35,6 +43,7 @@ void Camera::Move(int x, int y)
 	const float zoomMultiplier{ 1.0f / m_Zoom };
 	m_Position.x += static_cast<int>(x * zoomMultiplier);
 	m_Position.y += static_cast<int>(y * zoomMultiplier);
+	++m_Version;
 }
 
 Vector2 Camera::ScalePoint(const Vector2& point) const
@@ -49,4 +58,28 @@ Vector2 Camera::ScalePoint(const Vector2& point) const
 int Camera::ScaleSize(int size) const
 {
 	return static_cast<int>(size * m_Zoom);
+}
+
+void Camera::GetVisibleArea(Vector2& position, Vector2& size) const
+{
+	// Undo ScalePoint for the corners of the screen, with a margin of one unit for the rounding
+	const float zoomMultiplier{ 1.0f / m_Zoom };
+	position.x = static_cast<int>(std::floor(-m_Center.x * zoomMultiplier + m_Center.x - m_Position.x)) - 1;
+	position.y = static_cast<int>(std::floor(-m_Center.y * zoomMultiplier + m_Center.y - m_Position.y)) - 1;
+	size.x = static_cast<int>(std::ceil(m_ScreenSize.x * zoomMultiplier)) + 2;
+	size.y = static_cast<int>(std::ceil(m_ScreenSize.y * zoomMultiplier)) + 2;
+}
+
+bool Camera::IsOnScreen(const Vector2& scaledPosition, const Vector2& scaledSize) const
+{
+	// Outlines cover their last pixel, so a rect of size 0 is still drawn
+	return scaledPosition.x <= m_ScreenSize.x && scaledPosition.x + scaledSize.x >= 0 &&
+		scaledPosition.y <= m_ScreenSize.y && scaledPosition.y + scaledSize.y >= 0;
+}
+
+bool Camera::IsLineOnScreen(const Vector2& scaledP0, const Vector2& scaledP1) const
+{
+	// Test the bounds of the line, a line that crosses a corner of the screen is drawn even if it misses the screen
+	return min(scaledP0.x, scaledP1.x) <= m_ScreenSize.x && max(scaledP0.x, scaledP1.x) >= 0 &&
+		min(scaledP0.y, scaledP1.y) <= m_ScreenSize.y && max(scaledP0.y, scaledP1.y) >= 0;
 }
\ No newline at end of file
@@ -17,11 +17,22 @@ public:
 	// Member functions						
 	//-------------------------------------------------
 	void SetCenter(const Vector2& center);
+	void SetScreenSize(const Vector2& screenSize);
 	void AddZoom(float value);
 	void Move(int x, int y);
 
 	Vector2 ScalePoint(const Vector2& point) const;
 	int ScaleSize(int size) const;
+
+	// Changes every time the camera moves or zooms, or the screen changes size
+	int GetVersion() const { return m_Version; }
+
+	// The part of the world that is on screen
+	void GetVisibleArea(Vector2& position, Vector2& size) const;
+
+	// Whether a rect or a line that is already scaled to the screen is (partly) on screen
+	bool IsOnScreen(const Vector2& scaledPosition, const Vector2& scaledSize) const;
+	bool IsLineOnScreen(const Vector2& scaledP0, const Vector2& scaledP1) const;
 private:
 	//-------------------------------------------------
 	// Datamembers								
@@ -31,6 +42,8 @@ private:
 	float m_Zoom{ 1 };
 	Vector2 m_Center{};
 	Vector2 m_Position{};
+	Vector2 m_ScreenSize{};
+	int m_Version{};
 };
 
 #define CAMERA (Camera::GetSingleton())
\ No newline at end of file
@@ -1,7 +1,18 @@
 #pragma once
+#ifdef DUNGEON_HEADLESS
+// Headless builds don't link the game engine, only the standard library is available
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+using std::min;
+using std::max;
+using std::abs;
+#else
 #include "GameEngine.h"
 #include "GameDefines.h"
-#include <set>
+#endif
+#include <vector>
+#include <utility>
 
 struct Vector2
 {
@@ -47,14 +58,18 @@ struct Vector2
 		return x == other.x && y == other.y;
 	}
 
-	int DistanceSqr(const Vector2& other) const
+	// Calculated with 64 bit integers, so points that are far apart don't overflow
+	long long DistanceSqr(const Vector2& other) const
 	{
-		return (other.x - x) * (other.x - x) + (other.y - y) * (other.y - y);
+		const long long distanceX{ static_cast<long long>(other.x) - x };
+		const long long distanceY{ static_cast<long long>(other.y) - y };
+		return distanceX * distanceX + distanceY * distanceY;
 	}
 
 	float ToDirection()
 	{
-		const float length{ sqrtf(static_cast<float>(x * x + y * y)) };
+		// The squared length is calculated with 64 bit integers, so directions longer than 46340 don't overflow
+		const float length{ sqrtf(static_cast<float>(static_cast<long long>(x) * x + static_cast<long long>(y) * y)) };
 		const float xRanged{ static_cast<float>(x) / length };
 		const float yRanged{ static_cast<float>(y) / length };
 
@@ -79,12 +94,23 @@ struct Color
 	int g{};
 	int b{};
 
+#ifndef DUNGEON_HEADLESS
 	COLORREF GetColor() const { return RGB(r, g, b); }
+#endif
 };
 
 struct Triangle
 {
 	int first{}, second{}, third{};
+
+	int& operator[](int idx)
+	{
+		return idx == 0 ? first : idx == 1 ? second : third;
+	}
+	int operator[](int idx) const
+	{
+		return idx == 0 ? first : idx == 1 ? second : third;
+	}
 };
 
 struct Edge
@@ -98,46 +124,126 @@ struct Edge
 	}
 	bool operator<(const Edge& other) const
 	{
-		return p0.first.DistanceSqr(p1.first) < other.p0.first.DistanceSqr(other.p1.first);
+		// Sort by length first
+		const long long length{ p0.first.DistanceSqr(p1.first) };
+		const long long otherLength{ other.p0.first.DistanceSqr(other.p1.first) };
+		if (length != otherLength) return length < otherLength;
+
+		// Edges with the same length are sorted by their vertices, only the same edge is seen as equal
+		const int minVertex{ min(p0.second, p1.second) };
+		const int otherMinVertex{ min(other.p0.second, other.p1.second) };
+		if (minVertex != otherMinVertex) return minVertex < otherMinVertex;
+
+		return max(p0.second, p1.second) < max(other.p0.second, other.p1.second);
+	}
+};
+
+struct DisjointSet
+{
+	std::vector<int> parents{};
+	std::vector<int> ranks{};
+
+	void Reset(size_t size)
+	{
+		parents.resize(size);
+		ranks.assign(size, 0);
+
+		// Every element starts in its own set
+		for (size_t i{}; i < size; ++i)
+		{
+			parents[i] = static_cast<int>(i);
+		}
+	}
+
+	int Find(int element)
+	{
+		// Walk to the root, halving the path on the way so later searches are shorter
+		while (parents[element] != element)
+		{
+			parents[element] = parents[parents[element]];
+			element = parents[element];
+		}
+		return element;
+	}
+
+	int Union(int element0, int element1)
+	{
+		int root0{ Find(element0) };
+		int root1{ Find(element1) };
+
+		if (root0 == root1) return root0;
+
+		// Hang the shallowest tree under the deepest tree
+		if (ranks[root0] < ranks[root1]) std::swap(root0, root1);
+		parents[root1] = root0;
+		if (ranks[root0] == ranks[root1]) ++ranks[root0];
+
+		// Return the root of the merged set
+		return root0;
 	}
 };
 
-enum class TreeConnectionState
+// A read-only view on a contiguous part of a container
+struct IndexRange
 {
-	Not_Connected,
-	Connected,
-	Loop
+	const int* first{};
+	const int* last{};
+
+	const int* begin() const { return first; }
+	const int* end() const { return last; }
+	size_t size() const { return static_cast<size_t>(last - first); }
+	bool empty() const { return first == last; }
+	int operator[](size_t idx) const { return first[idx]; }
 };
 
-struct Tree
+// Compressed sparse row adjacency, the neighbours of vertex i are stored in neighbours[offsets[i]] up to neighbours[offsets[i + 1]]
+struct AdjacencyList
 {
-	std::vector<Edge> edges{};
-	std::set<int> vertices{};
+	std::vector<int> offsets{};
+	std::vector<int> neighbours{};
 
-	TreeConnectionState IsConnected(const Edge& edge) const
+	void Clear()
 	{
-		const bool foundP0{ vertices.find(edge.p0.second) != vertices.end() };
-		const bool foundP1{ vertices.find(edge.p1.second) != vertices.end() };
-		
-		if (foundP0 && foundP1)
+		offsets.clear();
+		neighbours.clear();
+	}
+
+	// Build the adjacency from a list of directed links (from, to), the neighbours of each vertex keep the order of the links
+	void Build(size_t nrVertices, const std::vector<std::pair<int, int>>& links)
+	{
+		// Count the neighbours of each vertex
+		offsets.assign(nrVertices + 1, 0);
+		for (const std::pair<int, int>& link : links)
 		{
-			// If the edge is connected with both points, return that this edge would make the tree loop
-			return TreeConnectionState::Loop;
+			++offsets[link.first + 1];
 		}
-		else if (foundP0 || foundP1)
+
+		// Turn the counts into the start of each vertex
+		for (size_t i{ 1 }; i < offsets.size(); ++i)
 		{
-			// If the edge is connected with only one point, return that this edge is connected to the tree
-			return TreeConnectionState::Connected;
+			offsets[i] += offsets[i - 1];
 		}
 
-		// Else, the edge is not connected to this tree
-		return TreeConnectionState::Not_Connected;
+		// Place every neighbour, offsets[i] is used as the insert position of vertex i and ends at the start of vertex i + 1
+		neighbours.resize(links.size());
+		for (const std::pair<int, int>& link : links)
+		{
+			neighbours[offsets[link.first]++] = link.second;
+		}
+
+		// Shift the insert positions back to the start of each vertex
+		for (size_t i{ nrVertices }; i > 0; --i)
+		{
+			offsets[i] = offsets[i - 1];
+		}
+		offsets[0] = 0;
 	}
 
-	void Merge(const Tree& other)
+	size_t GetNrVertices() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+	int GetDegree(int vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+	IndexRange GetNeighbours(int vertex) const
 	{
-		edges.reserve(edges.size() + other.edges.size());
-		edges.insert(edges.end(), other.edges.begin(), other.edges.end());
-		vertices.insert(other.vertices.begin(), other.vertices.end());
+		const int* pNeighbours{ neighbours.data() };
+		return IndexRange{ pNeighbours + offsets[vertex], pNeighbours + offsets[vertex + 1] };
 	}
 };
\ No newline at end of file
@@ -1,8 +1,9 @@
 //---------------------------
 // Includes
 //---------------------------
-#define _USE_MATH_DEFINES
 #include "DelaunayTriangulation.h"
+#include "Profiler.h"
+#include <climits>
 
 //---------------------------
 // Member functions
@@ -12,32 +13,118 @@ void DelaunayTriangulation::Triangulate(std::vector<DungeonRoom>& rooms)
 	// Clear the used containers
 	Clear();
 
+	// Calculate the bounds of the room centers
+	Vector2 minCenter{};
+	Vector2 maxCenter{};
+	if (!rooms.empty())
+	{
+		minCenter = rooms[0].GetPosition() + rooms[0].GetSize() / 2;
+		maxCenter = minCenter;
+		for (const DungeonRoom& room : rooms)
+		{
+			const Vector2 center{ room.GetPosition() + room.GetSize() / 2 };
+			minCenter.x = min(minCenter.x, center.x);
+			minCenter.y = min(minCenter.y, center.y);
+			maxCenter.x = max(maxCenter.x, center.x);
+			maxCenter.y = max(maxCenter.y, center.y);
+		}
+	}
+
 	// Set up all data needed for the triangulation algorithm
-	StartTriangulation();
+	StartTriangulation(minCenter, maxCenter);
 
-	// For each room
-	for (int i{}; i < rooms.size(); ++i)
+	if (!rooms.empty())
 	{
-		// Get the current room
-		const DungeonRoom& room{ rooms[i] };
+		// The size of the bounds, can't be 0 because it is used as a divisor
+		const long long rangeX{ max(static_cast<long long>(maxCenter.x) - minCenter.x, 1LL) };
+		const long long rangeY{ max(static_cast<long long>(maxCenter.y) - minCenter.y, 1LL) };
+
+		// Sort the rooms along a hilbert curve, every new point is close to the previous point which keeps the walk to its triangle short
+		m_InsertionOrder.clear();
+		m_InsertionOrder.reserve(rooms.size());
+		for (int i{}; i < static_cast<int>(rooms.size()); ++i)
+		{
+			const Vector2 center{ rooms[i].GetPosition() + rooms[i].GetSize() / 2 };
+			const unsigned int gridX{ static_cast<unsigned int>((static_cast<long long>(center.x) - minCenter.x) * 65535 / rangeX) };
+			const unsigned int gridY{ static_cast<unsigned int>((static_cast<long long>(center.y) - minCenter.y) * 65535 / rangeY) };
+			m_InsertionOrder.push_back(std::make_pair(GetHilbertIndex(gridX, gridY), i));
+		}
+		std::sort(m_InsertionOrder.begin(), m_InsertionOrder.end());
+
+		// For each room
+		for (const std::pair<unsigned int, int>& insertion : m_InsertionOrder)
+		{
+			// Get the current room
+			const DungeonRoom& room{ rooms[insertion.second] };
 
-		// Add the center of the room to the triangulation
-		AddPoint(room.GetPosition() + room.GetSize() / 2, i);
+			// Add the center of the room to the triangulation
+			AddPoint(room.GetPosition() + room.GetSize() / 2, insertion.second);
+		}
 	}
 
 	// Finish up the triangulation algorithm
 	FinishTriangulation();
 }
 
-void DelaunayTriangulation::StartTriangulation()
+void DelaunayTriangulation::StartTriangulation(const Vector2& minPoint, const Vector2& maxPoint)
 {
+	// How much bigger the super triangle is than the bounds, a small super triangle leaves out triangles on the border of the dungeon
+	constexpr long long superTriangleScale{ 20 };
+
+	// The super triangle dungeons around the default center have always used, so their layouts stay the same
+	Vector2 superVertices[3]{ { -3000, -3000 }, { -3000, 9500 }, { 9000, -3500 } };
+
+	// If a corner of the bounds is not inside that triangle, some rooms would be left out
+	// Use a super triangle around the bounds instead, it contains the bounds with room to spare on every side
+	const Vector2 corners[4]{ minPoint, { minPoint.x, maxPoint.y }, maxPoint, { maxPoint.x, minPoint.y } };
+	bool isInsideSuperTriangle{ true };
+	for (const Vector2& corner : corners)
+	{
+		const long long orientation0{ Orientation(superVertices[0], superVertices[1], corner) };
+		const long long orientation1{ Orientation(superVertices[1], superVertices[2], corner) };
+		const long long orientation2{ Orientation(superVertices[2], superVertices[0], corner) };
+		const bool isInside{ (orientation0 > 0 && orientation1 > 0 && orientation2 > 0) || (orientation0 < 0 && orientation1 < 0 && orientation2 < 0) };
+		if (!isInside) isInsideSuperTriangle = false;
+	}
+
+	if (!isInsideSuperTriangle)
+	{
+		// The in circle test is exact while vertices are less than 2^31 apart, so the super triangle stays within 2^30 of the center
+		constexpr long long maxSuperTriangleDistance{ 1LL << 30 };
+		// The smallest scale of which the triangle still contains the bounds
+		constexpr long long minSuperTriangleScale{ 3 };
+
+		const long long centerX{ (static_cast<long long>(minPoint.x) + maxPoint.x) / 2 };
+		const long long centerY{ (static_cast<long long>(minPoint.y) + maxPoint.y) / 2 };
+		const long long extent{ max(static_cast<long long>(maxPoint.x) - minPoint.x, static_cast<long long>(maxPoint.y) - minPoint.y) / 2 + 1 };
+
+		// Use a smaller triangle when the default one would be too far from the center, or outside of the range of an int
+		const long long maxScaleDistance{ maxSuperTriangleDistance / extent - 1 };
+		const long long maxScaleInt{ (INT_MAX - max(abs(centerX), abs(centerY))) / extent };
+		const long long scale{ max(min(superTriangleScale, min(maxScaleDistance, maxScaleInt)), minSuperTriangleScale) };
+
+		// Bounds that don't fit even the smallest triangle are not supported, the vertices are clamped so they don't wrap around
+		const auto toCoordinate{ [](long long coordinate) { return static_cast<int>(max(min(coordinate, static_cast<long long>(INT_MAX)), static_cast<long long>(INT_MIN))); } };
+		superVertices[0] = Vector2{ toCoordinate(centerX - scale * extent), toCoordinate(centerY - 2 * extent) };
+		superVertices[1] = Vector2{ toCoordinate(centerX + scale * extent), toCoordinate(centerY - 2 * extent) };
+		superVertices[2] = Vector2{ toCoordinate(centerX), toCoordinate(centerY + scale * extent) };
+	}
+
 	// Create super triangle vertices
-	AddVertex({ -3000, -3000 }, -1);
-	AddVertex({ -3000, 9500 }, -1);
-	AddVertex({ 9000, -3500 }, -1);
+	AddVertex(superVertices[0], -1);
+	AddVertex(superVertices[1], -1);
+	AddVertex(superVertices[2], -1);
 
-	// Create the super triangle
-	AddTriangle(0, 1, 2);
+	// Create the super triangle, every triangle is stored counter clockwise and the super triangle has no neighbours
+	if (Orientation(m_Vertices[0].first, m_Vertices[1].first, m_Vertices[2].first) > 0)
+	{
+		SetTriangle(0, Triangle{ 0, 1, 2 }, Triangle{ -1, -1, -1 });
+	}
+	else
+	{
+		SetTriangle(0, Triangle{ 0, 2, 1 }, Triangle{ -1, -1, -1 });
+	}
+	m_LastTriangle = 0;
 }
 
 void DelaunayTriangulation::AddPoint(const Vector2& point, int dungeonRoomIdx)
@@ -45,85 +132,96 @@ void DelaunayTriangulation::AddPoint(const Vector2& point, int dungeonRoomIdx)
 	// Add the center of the room as a vertex
 	const int newIndice{ AddVertex(point, dungeonRoomIdx) };
 
-	// Polygon formed by the intersecting triangles
-	std::vector<int> intersectingPolygon{};
+	// Find the triangle that contains the new point, if the point is outside the super triangle it can't be added
+	const int containingTriangle{ FindContainingTriangle(point) };
+	if (containingTriangle < 0) return;
 
-	// For each triangle (in reverse order so we can delete triangles safely)
-	for (int i{ static_cast<int>(m_Triangles.size()) - 1 }; i >= 0; --i)
-	{
-		// Cast the index to a size_t
-		const size_t index{ static_cast<size_t>(i) };
+	// Start a new cavity search, a triangle is inside the cavity if its mark is 2 * m_CurMark, rejected if 2 * m_CurMark + 1
+	++m_CurMark;
+	if (m_TriangleMarks.size() < m_Triangles.size()) m_TriangleMarks.resize(m_Triangles.size());
+	const int cavityMark{ 2 * m_CurMark };
+	const int rejectedMark{ 2 * m_CurMark + 1 };
 
-		// If the new point is not in a circumcircle of the triangle, continue to the next triangle
-		if (!IsInsideCircumcircle(m_Triangles[index], newIndice)) continue;
+	// The containing triangle is always part of the cavity
+	m_Cavity.clear();
+	m_CavityEdges.clear();
+	m_Cavity.push_back(containingTriangle);
+	m_TriangleMarks[containingTriangle] = cavityMark;
+
+	// Flood fill from the containing triangle to every neighbour whose circumcircle contains the new point (the cavity grows while looping)
+	for (size_t cavityIdx{}; cavityIdx < m_Cavity.size(); ++cavityIdx)
+	{
+		const int triangleIdx{ m_Cavity[cavityIdx] };
 
-		// If the intersecting polygon already has vertices
-		if (!intersectingPolygon.empty())
+		// For each edge of the triangle
+		for (int edge{}; edge < 3; ++edge)
 		{
-			// If the points are already in the intersecting polygon
-			bool hasFirst{}, hasSecond{}, hasThird{};
+			const int neighbour{ m_Neighbours[triangleIdx][edge] };
 
-			// For each vertex on the polygon
-			for (size_t polygonIdx{}; polygonIdx < intersectingPolygon.size(); ++polygonIdx)
+			if (neighbour >= 0)
 			{
-				// If a vertex of the triangle is already in the intersecting polygon, set the corresponding boolean on true
-				if (intersectingPolygon[polygonIdx] == m_Triangles[index].first)
-				{
-					hasFirst = true;
-				}
-				if (intersectingPolygon[polygonIdx] == m_Triangles[index].second)
-				{
-					hasSecond = true;
-				}
-				if (intersectingPolygon[polygonIdx] == m_Triangles[index].third)
+				// If the neighbour is already part of the cavity, this edge is inside the cavity
+				if (m_TriangleMarks[neighbour] == cavityMark) continue;
+
+				// If the neighbour has not been tested yet and the new point is inside its circumcircle, add it to the cavity
+				if (m_TriangleMarks[neighbour] != rejectedMark)
 				{
-					hasThird = true;
+					if (IsInsideCircumcircle(neighbour, newIndice))
+					{
+						m_TriangleMarks[neighbour] = cavityMark;
+						m_Cavity.push_back(neighbour);
+						continue;
+					}
+					m_TriangleMarks[neighbour] = rejectedMark;
 				}
 			}
 
-			// Add the vertices of the triangle to the intersecting polygon if they are not yet in the polygon
-			if (!hasFirst) intersectingPolygon.push_back(m_Triangles[index].first);
-			if (!hasSecond) intersectingPolygon.push_back(m_Triangles[index].second);
-			if (!hasThird) intersectingPolygon.push_back(m_Triangles[index].third);
-		}
-		else
-		{
-			// If the polygon does not have vertices yet, add the vertices of the triangle to the intersecting polygon
-			intersectingPolygon.push_back(m_Triangles[index].first);
-			intersectingPolygon.push_back(m_Triangles[index].second);
-			intersectingPolygon.push_back(m_Triangles[index].third);
+			// This edge is on the border of the cavity
+			const Triangle& triangle{ m_Triangles[triangleIdx] };
+			m_CavityEdges.push_back(CavityEdge{ triangle[edge], triangle[(edge + 1) % 3], neighbour });
 		}
-
-		// Remove the current triangle
-		RemoveTriangle(index);
 	}
 
-	// Sort the vertices of the polygon by angle
-	std::sort(
-		intersectingPolygon.begin(),
-		intersectingPolygon.end(),
-		[&](int indice0, int indice1)
+	// Make sure every vertex can be looked up
+	if (m_NewTriangleFromVertex.size() < m_Vertices.size()) m_NewTriangleFromVertex.resize(m_Vertices.size());
+
+	// Create a triangle between every border edge and the new vertex, the slots of the removed triangles are reused
+	for (size_t i{}; i < m_CavityEdges.size(); ++i)
+	{
+		const CavityEdge& cavityEdge{ m_CavityEdges[i] };
+
+		const int triangleIdx{ i < m_Cavity.size() ? m_Cavity[i] : static_cast<int>(m_Triangles.size()) };
+		SetTriangle(triangleIdx, Triangle{ cavityEdge.from, cavityEdge.to, newIndice }, Triangle{ cavityEdge.outsideTriangle, -1, -1 });
+
+		// Store which new triangle starts at this vertex, so the new triangles can be linked together
+		m_NewTriangleFromVertex[cavityEdge.from] = triangleIdx;
+
+		// Link the triangle outside the cavity to the new triangle
+		if (cavityEdge.outsideTriangle >= 0)
 		{
-			// Get the vectors from the new point to the current points
-			const Vector2 vector0{ m_Vertices[indice0].first - point };
-			const Vector2 vector1{ m_Vertices[indice1].first - point };
-			// Calculate the angle of these vectors
-			float angle0{ atan2f(static_cast<float>(vector0.y), static_cast<float>(vector0.x)) };
-			float angle1{ atan2f(static_cast<float>(vector1.y), static_cast<float>(vector1.x)) };
-			// Make sure the angles are between 0 and 2PI
-			if (angle0 < 0) angle0 = angle0 + 2.0f * static_cast<float>(M_PI);
-			if (angle1 < 0) angle1 = angle1 + 2.0f * static_cast<float>(M_PI);
-			// Return if the current angle is smaller then the previous angles
-			return angle0 < angle1;
+			const Triangle& outsideTriangle{ m_Triangles[cavityEdge.outsideTriangle] };
+			for (int edge{}; edge < 3; ++edge)
+			{
+				if (outsideTriangle[edge] != cavityEdge.to || outsideTriangle[(edge + 1) % 3] != cavityEdge.from) continue;
+
+				m_Neighbours[cavityEdge.outsideTriangle][edge] = triangleIdx;
+				break;
+			}
 		}
-	);
+	}
 
-	// For each edge in the intersecting polygon
-	for (size_t i{}; i < intersectingPolygon.size(); ++i)
+	// Link the new triangles with each other, the edge "to - new vertex" borders the triangle that starts at "to"
+	for (size_t i{}; i < m_CavityEdges.size(); ++i)
 	{
-		// Create a triangle between the current edge and the new vertex
-		AddTriangle(intersectingPolygon[i], intersectingPolygon[(i + 1) % intersectingPolygon.size()], newIndice);
+		const int triangleIdx{ m_NewTriangleFromVertex[m_CavityEdges[i].from] };
+		const int nextTriangleIdx{ m_NewTriangleFromVertex[m_CavityEdges[i].to] };
+
+		m_Neighbours[triangleIdx].second = nextTriangleIdx;
+		m_Neighbours[nextTriangleIdx].third = triangleIdx;
 	}
+
+	// The next point will most likely be close to this point, start the next walk from here
+	m_LastTriangle = m_NewTriangleFromVertex[m_CavityEdges[0].from];
 }
 
 void DelaunayTriangulation::FinishTriangulation()
@@ -148,12 +246,25 @@ void DelaunayTriangulation::FinishTriangulation()
 			}
 		}
 	}
+
+	// Removing triangles invalidates the neighbours and circumcircles
+	m_Neighbours.clear();
+	m_Circumcircles.clear();
 }
 
 void DelaunayTriangulation::Clear()
 {
 	m_Triangles.clear();
 	m_Vertices.clear();
+	m_Neighbours.clear();
+	m_Circumcircles.clear();
+	m_LastTriangle = 0;
+
+	// Restart the marks, a generator that is reused for many dungeons would otherwise overflow 2 * m_CurMark
+	m_TriangleMarks.clear();
+	m_CurMark = 0;
+
+	if (m_pListener) m_pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::TrianglesCleared });
 }
 
 size_t DelaunayTriangulation::GetSize() const
@@ -162,37 +273,262 @@ size_t DelaunayTriangulation::GetSize() const
 	return m_Vertices.size() - 3;
 }
 
-bool DelaunayTriangulation::IsInsideCircumcircle(const Triangle& triangle, int indice)
+void DelaunayTriangulation::SetTriangle(int triangleIdx, const Triangle& triangle, const Triangle& neighbours)
+{
+	PROFILE_COUNT(TrianglesCreated, 1);
+
+	if (triangleIdx == static_cast<int>(m_Triangles.size()))
+	{
+		// Add a new triangle if the index is past the last triangle
+		AddTriangle(triangle.first, triangle.second, triangle.third);
+		m_Neighbours.push_back(neighbours);
+	}
+	else
+	{
+		// Overwrite the triangle
+		m_Triangles[triangleIdx] = triangle;
+		m_Neighbours[triangleIdx] = neighbours;
+	}
+
+	// Report the rooms of the corners, the corners of the super triangle aren't rooms
+	if (m_pListener)
+	{
+		m_pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::TriangleSet, triangleIdx,
+			{ m_Vertices[triangle.first].second, m_Vertices[triangle.second].second, m_Vertices[triangle.third].second } });
+	}
+
+	if (!m_IsCachingCircumcircles) return;
+
+	// Cache the circumcircle, triangles without a cached circle fall back to the exact test
+	if (m_Circumcircles.size() < m_Triangles.size()) m_Circumcircles.resize(m_Triangles.size());
+	m_Circumcircles[triangleIdx] = CalculateCircumcircle(triangle);
+}
+
+DelaunayTriangulation::Circumcircle DelaunayTriangulation::CalculateCircumcircle(const Triangle& triangle) const
+{
+	// Get the vertices of the triangle
+	const Vector2& v0{ m_Vertices[triangle.first].first };
+	const Vector2& v1{ m_Vertices[triangle.second].first };
+	const Vector2& v2{ m_Vertices[triangle.third].first };
+
+	// Calculate everything relative to the first vertex, this keeps the numbers small
+	const double x1{ static_cast<double>(v1.x) - v0.x };
+	const double y1{ static_cast<double>(v1.y) - v0.y };
+	const double x2{ static_cast<double>(v2.x) - v0.x };
+	const double y2{ static_cast<double>(v2.y) - v0.y };
+
+	// If the vertices are on one line, there is no circumcircle
+	const double cross{ 2.0 * (x1 * y2 - y1 * x2) };
+	if (cross == 0.0) return Circumcircle{};
+
+	// Calculate the center of the circle
+	const double length1{ x1 * x1 + y1 * y1 };
+	const double length2{ x2 * x2 + y2 * y2 };
+	const double centerX{ (y2 * length1 - y1 * length2) / cross };
+	const double centerY{ (x1 * length2 - x2 * length1) / cross };
+
+	return Circumcircle{ v0.x + centerX, v0.y + centerY, centerX * centerX + centerY * centerY, true };
+}
+
+bool DelaunayTriangulation::IsInsideCircumcircle(int triangleIdx, int indice) const
+{
+	// Get the current triangle and the vertex to test
+	const Triangle& triangle{ m_Triangles[triangleIdx] };
+	const Vector2& vTest{ m_Vertices[indice].first };
+
+	if (m_IsCachingCircumcircles && triangleIdx < static_cast<int>(m_Circumcircles.size()))
+	{
+		const Circumcircle& circumcircle{ m_Circumcircles[triangleIdx] };
+		if (circumcircle.isValid)
+		{
+			// Calculate the distance between the center and the vertex
+			const double distanceX{ vTest.x - circumcircle.centerX };
+			const double distanceY{ vTest.y - circumcircle.centerY };
+			const double distanceSqr{ distanceX * distanceX + distanceY * distanceY };
+
+			// The rounding errors of the cached circle are far smaller than this margin
+			const double margin{ circumcircle.radiusSqr * 1e-9 + 1e-6 };
+
+			// Only points close to the circle need the exact test
+			if (distanceSqr < circumcircle.radiusSqr - margin) return true;
+			if (distanceSqr > circumcircle.radiusSqr + margin) return false;
+		}
+	}
+
+	// Return true if the new vertex is inside the circle, triangles are always counter clockwise
+	return InCircle(m_Vertices[triangle.first].first, m_Vertices[triangle.second].first, m_Vertices[triangle.third].first, vTest) > 0;
+}
+
+int DelaunayTriangulation::FindContainingTriangle(const Vector2& point) const
 {
-	// Get the vertices of the current triangle
-	const auto& v0{ m_Vertices[triangle.first] };
-	const auto& v1{ m_Vertices[triangle.second] };
-	const auto& v2{ m_Vertices[triangle.third] };
-	// Get the current vertex to add
-	const auto& vTest{ m_Vertices[indice] };
+	if (m_Triangles.empty()) return -1;
+
+	// Start walking from the last created triangle
+	int triangleIdx{ m_LastTriangle < static_cast<int>(m_Triangles.size()) ? m_LastTriangle : 0 };
+
+	// A walk never needs more steps than there are triangles
+	for (size_t step{}; step < m_Triangles.size(); ++step)
+	{
+		const Triangle& triangle{ m_Triangles[triangleIdx] };
 
-	// Calculate the slopes of the perpendicular lines of edges 01 and 02
-	const float perpSlope0{ (v0.first.x - v1.first.x) / static_cast<float>(v1.first.y - v0.first.y + FLT_EPSILON) };
-	const float perpSlope1{ (v0.first.x - v2.first.x) / static_cast<float>(v2.first.y - v0.first.y + FLT_EPSILON) };
+		// The next triangle of the walk
+		int nextTriangleIdx{ triangleIdx };
 
-	// Calculate the center of the edges
-	const Vector2 edge01Center{ (v0.first + v1.first) / 2 };
-	const Vector2 edge02Center{ (v0.first + v2.first) / 2 };
+		// For each edge, starting at a different edge every step so the walk can't keep circling around the same triangles
+		for (int i{}; i < 3; ++i)
+		{
+			const int edge{ static_cast<int>((i + step) % 3) };
+
+			// If the point is on the outside of this edge, walk to the neighbour across this edge
+			if (Orientation(m_Vertices[triangle[edge]].first, m_Vertices[triangle[(edge + 1) % 3]].first, point) < 0)
+			{
+				nextTriangleIdx = m_Neighbours[triangleIdx][edge];
+				break;
+			}
+		}
+
+		// If the point is not on the outside of any edge, this triangle contains the point
+		if (nextTriangleIdx == triangleIdx) return triangleIdx;
+
+		// If there is no triangle across this edge, the point is outside of the super triangle
+		if (nextTriangleIdx < 0) return -1;
+
+		triangleIdx = nextTriangleIdx;
+	}
 
-	// Calculate the intercept of the lines using the calculated slopes and the center of the edges
-	const float intercept0{ edge01Center.y - perpSlope0 * edge01Center.x };
-	const float intercept1{ edge02Center.y - perpSlope1 * edge02Center.x };
+	// If the walk did not end, check every triangle
+	for (int i{}; i < static_cast<int>(m_Triangles.size()); ++i)
+	{
+		if (IsInsideTriangle(m_Triangles[i], point)) return i;
+	}
 
-	// Calculate the intersection of the two perpendicular lines, this is the center of the circle
-	const int x{ static_cast<int>((intercept1 - intercept0) / (perpSlope0 - perpSlope1)) };
-	const int y{ static_cast<int>(perpSlope0 * x + intercept0) };
+	return -1;
+}
 
-	// Calculate the radius of the circle
-	const int r{ (x - v1.first.x) * (x - v1.first.x) + (y - v1.first.y) * (y - v1.first.y) };
+bool DelaunayTriangulation::IsInsideTriangle(const Triangle& triangle, const Vector2& point) const
+{
+	// The point is inside a counter clockwise triangle if it is not on the right side of any edge
+	for (int edge{}; edge < 3; ++edge)
+	{
+		if (Orientation(m_Vertices[triangle[edge]].first, m_Vertices[triangle[(edge + 1) % 3]].first, point) < 0) return false;
+	}
+	return true;
+}
 
-	// Calculate the distance between the center and the new vertex
-	const int rPoint{ (x - vTest.first.x) * (x - vTest.first.x) + (y - vTest.first.y) * (y - vTest.first.y) };
+long long DelaunayTriangulation::Orientation(const Vector2& v0, const Vector2& v1, const Vector2& v2)
+{
+	// Positive if the points are counter clockwise, negative if clockwise and 0 if they are on one line
+	// The differences are taken with 64 bit integers, vertices can be more than the range of an int apart
+	const long long x1{ static_cast<long long>(v1.x) - v0.x };
+	const long long y1{ static_cast<long long>(v1.y) - v0.y };
+	const long long x2{ static_cast<long long>(v2.x) - v0.x };
+	const long long y2{ static_cast<long long>(v2.y) - v0.y };
+	return x1 * y2 - y1 * x2;
+}
+
+long long DelaunayTriangulation::InCircle(const Vector2& v0, const Vector2& v1, const Vector2& v2, const Vector2& vTest)
+{
+	// The distance up to which the determinant fits in 64 bits
+	constexpr long long maxSmallDistance{ 29000 };
+
+	// Move the test vertex to the origin
+	const long long x0{ static_cast<long long>(v0.x) - vTest.x };
+	const long long y0{ static_cast<long long>(v0.y) - vTest.y };
+	const long long x1{ static_cast<long long>(v1.x) - vTest.x };
+	const long long y1{ static_cast<long long>(v1.y) - vTest.y };
+	const long long x2{ static_cast<long long>(v2.x) - vTest.x };
+	const long long y2{ static_cast<long long>(v2.y) - vTest.y };
+
+	// Determinant of the lifted points
+	// Positive if the test vertex is inside the circle of a counter clockwise triangle, 0 if it is on the circle
+	const long long maxDistance{ max(max(max(abs(x0), abs(y0)), max(abs(x1), abs(y1))), max(abs(x2), abs(y2))) };
+	if (maxDistance < maxSmallDistance)
+	{
+		return (x0 * x0 + y0 * y0) * (x1 * y2 - x2 * y1)
+			- (x1 * x1 + y1 * y1) * (x0 * y2 - x2 * y0)
+			+ (x2 * x2 + y2 * y2) * (x0 * y1 - x1 * y0);
+	}
+
+	// Vertices that are further apart use 128 bit products, exact as long as the vertices are less than 2^31 apart
+	const Int128 determinant{ Add(Add(
+		Multiply(x0 * x0 + y0 * y0, x1 * y2 - x2 * y1),
+		Negate(Multiply(x1 * x1 + y1 * y1, x0 * y2 - x2 * y0))),
+		Multiply(x2 * x2 + y2 * y2, x0 * y1 - x1 * y0)) };
+
+	// Only the sign is used
+	if (static_cast<long long>(determinant.high) < 0) return -1;
+	return determinant.high == 0 && determinant.low == 0 ? 0 : 1;
+}
+
+DelaunayTriangulation::Int128 DelaunayTriangulation::Multiply(long long a, long long b)
+{
+	// Multiply the magnitudes in 32 bit parts
+	const bool isNegative{ (a < 0) != (b < 0) };
+	const uint64_t magnitudeA{ a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a) };
+	const uint64_t magnitudeB{ b < 0 ? 0 - static_cast<uint64_t>(b) : static_cast<uint64_t>(b) };
+
+	const uint64_t lowA{ magnitudeA & 0xFFFFFFFFULL };
+	const uint64_t highA{ magnitudeA >> 32 };
+	const uint64_t lowB{ magnitudeB & 0xFFFFFFFFULL };
+	const uint64_t highB{ magnitudeB >> 32 };
+
+	const uint64_t lowLow{ lowA * lowB };
+	const uint64_t lowHigh{ lowA * highB };
+	const uint64_t highLow{ highA * lowB };
+	const uint64_t highHigh{ highA * highB };
+
+	// Add the middle parts, keeping their carries
+	const uint64_t middle{ (lowLow >> 32) + (lowHigh & 0xFFFFFFFFULL) + (highLow & 0xFFFFFFFFULL) };
+
+	Int128 product{};
+	product.low = (middle << 32) | (lowLow & 0xFFFFFFFFULL);
+	product.high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+
+	return isNegative ? Negate(product) : product;
+}
+
+DelaunayTriangulation::Int128 DelaunayTriangulation::Add(const Int128& a, const Int128& b)
+{
+	Int128 sum{};
+	sum.low = a.low + b.low;
+	sum.high = a.high + b.high + (sum.low < a.low ? 1 : 0);
+	return sum;
+}
+
+DelaunayTriangulation::Int128 DelaunayTriangulation::Negate(const Int128& value)
+{
+	Int128 negated{};
+	negated.low = ~value.low + 1;
+	negated.high = ~value.high + (negated.low == 0 ? 1 : 0);
+	return negated;
+}
+
+unsigned int DelaunayTriangulation::GetHilbertIndex(unsigned int x, unsigned int y)
+{
+	// The size of the grid the coordinates are in
+	constexpr unsigned int gridSize{ 1u << 16 };
+
+	unsigned int index{};
+
+	// From the biggest quadrant to the smallest quadrant
+	for (unsigned int quadrantSize{ gridSize / 2 }; quadrantSize > 0; quadrantSize /= 2)
+	{
+		// Get the quadrant this point is in
+		const unsigned int quadrantX{ (x & quadrantSize) > 0 ? 1u : 0u };
+		const unsigned int quadrantY{ (y & quadrantSize) > 0 ? 1u : 0u };
+		index += quadrantSize * quadrantSize * ((3 * quadrantX) ^ quadrantY);
+
+		// Rotate the point so the curve inside the quadrant has the correct direction
+		if (quadrantY == 0)
+		{
+			if (quadrantX == 1)
+			{
+				x = gridSize - 1 - x;
+				y = gridSize - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
 
-	// Return true if the new vertex is inside the circle
-	return rPoint < r;
+	return index;
 }
@@ -4,6 +4,7 @@
 // Include Files
 //-----------------------------------------------------
 #include "Triangulation.h"
+#include <cstdint>
 
 //-----------------------------------------------------
 // DelaunayTriangulation Class									
@@ -19,15 +20,67 @@ public:
 	//-------------------------------------------------
 	virtual void Triangulate(std::vector<DungeonRoom>& rooms) override;
 
-	void StartTriangulation();
+	// Every point that is added has to be inside these bounds
+	void StartTriangulation(const Vector2& minPoint, const Vector2& maxPoint);
 	void AddPoint(const Vector2& point, int dungeonRoomIdx);
 	void FinishTriangulation();
 	void Clear();
+	void SetCircumcircleCacheState(bool isCachingCircumcircles) { m_IsCachingCircumcircles = isCachingCircumcircles; }
 	virtual size_t GetSize() const override;
 private:
 	//-------------------------------------------------
 	// Private member functions								
 	//-------------------------------------------------
-	bool IsInsideCircumcircle(const Triangle& triangle, int indice);
-};
+	struct CavityEdge
+	{
+		int from{};
+		int to{};
+		int outsideTriangle{};
+	};
+
+	// A signed 128 bit integer in two's complement, only what the exact in circle test of far apart vertices needs
+	struct Int128
+	{
+		uint64_t high{};
+		uint64_t low{};
+	};
+
+	struct Circumcircle
+	{
+		double centerX{};
+		double centerY{};
+		double radiusSqr{};
+		bool isValid{};
+	};
 
+	void SetTriangle(int triangleIdx, const Triangle& triangle, const Triangle& neighbours);
+	Circumcircle CalculateCircumcircle(const Triangle& triangle) const;
+	bool IsInsideCircumcircle(int triangleIdx, int indice) const;
+	int FindContainingTriangle(const Vector2& point) const;
+	bool IsInsideTriangle(const Triangle& triangle, const Vector2& point) const;
+	static long long Orientation(const Vector2& v0, const Vector2& v1, const Vector2& v2);
+	static long long InCircle(const Vector2& v0, const Vector2& v1, const Vector2& v2, const Vector2& vTest);
+	static Int128 Multiply(long long a, long long b);
+	static Int128 Add(const Int128& a, const Int128& b);
+	static Int128 Negate(const Int128& value);
+	static unsigned int GetHilbertIndex(unsigned int x, unsigned int y);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	// The neighbouring triangle across each edge (first-second, second-third, third-first), -1 if there is none
+	std::vector<Triangle> m_Neighbours{};
+	int m_LastTriangle{};
+
+	// The circumcircle of each triangle, used to skip the exact test for points that are clearly inside or outside
+	bool m_IsCachingCircumcircles{ true };
+	std::vector<Circumcircle> m_Circumcircles{};
+
+	// Scratch containers of the cavity search, reused for every point
+	std::vector<int> m_TriangleMarks{};
+	int m_CurMark{};
+	std::vector<int> m_Cavity{};
+	std::vector<CavityEdge> m_CavityEdges{};
+	std::vector<int> m_NewTriangleFromVertex{};
+	std::vector<std::pair<unsigned int, int>> m_InsertionOrder{};
+};
@@ -3,39 +3,121 @@
 //---------------------------
 #include "Dungeon.h"
 #include "DungeonGenerator.h"
+#include "KeyPlacer.h"
 #include "DungeonSolver.h"
+#ifndef DUNGEON_HEADLESS
+#include "Camera.h"
+#endif
+#include <algorithm>
 
 //---------------------------
 // Member functions
 //---------------------------
 void Dungeon::GenerateDungeon()
 {
-	// Generate the rooms of the dungeon
-	m_Generator.GenerateDungeon(m_Rooms);
+	// Generate the rooms of the dungeon, the layout is only known once the generator is done
+	m_LayoutSettings = m_Generator.GetLayoutSettings();
+	m_HasLayout = false;
+	m_Generator.GenerateDungeon(m_Rooms, m_Connections);
 
-	// Reset keys
+	// Reset keys and the shortest path
 	m_HasAddedKeys = false;
+	m_StartRoomIdx = -1;
+	m_EndRoomIdx = -1;
+	m_NrKeyRooms = 0;
+	m_NrLockedRooms = 0;
+	m_ShortestPath.clear();
+	m_IsOnShortestPath.clear();
+	m_KeyPlacementSeconds = 0.0;
+	++m_DrawVersion;
+#ifndef DUNGEON_HEADLESS
+	m_IsDrawGridDirty = true;
+#endif
 }
 
 void Dungeon::Update()
 {
 	// Update the generator
-	m_Generator.Update(m_Rooms);
+	m_Generator.Update(m_Rooms, m_Connections);
 
 	// If the generator is done and no keys have been generated, generate keys and locked rooms
 	if (m_Generator.IsDone() && !m_HasAddedKeys)
 	{
 		m_HasAddedKeys = true;
 
-		GenerateKeysAndLockedRooms();
+		// The generator only changes the rooms while it is busy, so the room types are counted once
+		IndexRooms();
+
+		// Remember the layout, a cancelled generation has no layout
+		m_HasLayout = !m_Generator.IsCancelled();
+		m_LayoutRandomState = m_Generator.GetRandomGenerator().GetState();
+
+		PlaceKeys();
+	}
+}
+
+bool Dungeon::HasLayout(const DungeonGenerator::LayoutSettings& settings) const
+{
+	// A dungeon without a seed gets a new layout every time
+	return m_HasLayout && m_LayoutSettings.seed >= 0 && m_LayoutSettings == settings;
+}
+
+void Dungeon::RegenerateKeys()
+{
+	if (!m_HasLayout) return;
+
+	// Remove the keys and locked rooms that are left, picked up keys and opened rooms are already normal rooms
+	for (int roomIdx{}; roomIdx < static_cast<int>(m_Rooms.size()); ++roomIdx)
+	{
+		const DungeonRoom::DungeonRoomType roomType{ m_Rooms[roomIdx].GetRoomType() };
+		if (roomType != DungeonRoom::DungeonRoomType::KeyRoom && roomType != DungeonRoom::DungeonRoomType::LockedRoom) continue;
+
+		SetRoomType(roomIdx, DungeonRoom::DungeonRoomType::Room);
+	}
+
+	// Start from the same random numbers as the first placement, the keys are the same as generating the whole dungeon with these key settings
+	m_Generator.GetRandomGenerator().SetState(m_LayoutRandomState);
+
+	PlaceKeys();
+}
+
+void Dungeon::SweepKeyCounts(int firstNrKeys, int lastNrKeys, std::vector<KeySweepResult>& results)
+{
+	results.clear();
+	if (!m_HasLayout || m_Rooms.empty()) return;
+
+	// Keep the key settings, they are placed again after the sweep
+	const int nrKeys{ m_NrKeys };
+
+	DungeonSolver solver{ shared_from_this() };
+	solver.SetNeedAllKeys(m_NeedAllKeys);
+
+	for (int sweepNrKeys{ firstNrKeys }; sweepNrKeys <= lastNrKeys; ++sweepNrKeys)
+	{
+		m_NrKeys = sweepNrKeys;
+		RegenerateKeys();
+
+		KeySweepResult result{};
+		result.nrKeys = sweepNrKeys;
+		result.nrPlacedKeys = m_NrKeyRooms;
+		result.keyPlacementSeconds = m_KeyPlacementSeconds;
+
+		// Solving picks up the keys, the next amount of keys removes every key again
+		result.isSolved = solver.Solve();
+		result.nrSolveSteps = solver.GetStepCount();
+
+		results.push_back(result);
 	}
+
+	m_NrKeys = nrKeys;
+	RegenerateKeys();
 }
 
 bool Dungeon::PickUpKeyInRoom(int roomIdx)
 {
 	if (m_Rooms[roomIdx].GetRoomType() != DungeonRoom::DungeonRoomType::KeyRoom) return false;
 
-	m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::Room);
+	SetRoomType(roomIdx, DungeonRoom::DungeonRoomType::Room);
 
 	return true;
 }
@@ -44,7 +126,7 @@ bool Dungeon::UseKeyInRoom(int roomIdx)
 {
 	if (m_Rooms[roomIdx].GetRoomType() != DungeonRoom::DungeonRoomType::LockedRoom) return false;
 
-	m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::Room);
+	SetRoomType(roomIdx, DungeonRoom::DungeonRoomType::Room);
 
 	return true;
 }
@@ -54,34 +136,31 @@ void Dungeon::SetNeedAllKeys(bool needAllKeys)
 	m_NeedAllKeys = needAllKeys;
 }
 
-int Dungeon::GetStartRoom() const
+Vector2 Dungeon::GetRoomPositionFromIndex(int roomIdx) const
 {
-	for (int i{}; i < m_Rooms.size(); ++i)
-	{
-		if (m_Rooms[i].GetRoomType() == DungeonRoom::DungeonRoomType::Start)
-			return i;
-	}
-	return -1;
+	return m_Rooms[roomIdx].GetPosition() + m_Rooms[roomIdx].GetSize() / 2;
 }
 
-int Dungeon::GetEndRoom() const
+IndexRange Dungeon::GetRoomConnectionsFromIndex(int roomIdx) const
 {
-	for (int i{}; i < m_Rooms.size(); ++i)
-	{
-		if (m_Rooms[i].GetRoomType() == DungeonRoom::DungeonRoomType::End)
-			return i;
-	}
-	return -1;
+	return m_Connections.GetNeighbours(roomIdx);
 }
 
-Vector2 Dungeon::GetRoomPositionFromIndex(int roomIdx) const
+void Dungeon::SetShortestPath(IndexRange shortestPath)
 {
-	return m_Rooms[roomIdx].GetPosition() + m_Rooms[roomIdx].GetSize() / 2;
+	m_ShortestPath.assign(shortestPath.begin(), shortestPath.end());
+
+	// Save which rooms are on the path, so solvers don't have to search the path
+	m_IsOnShortestPath.assign(m_Rooms.size(), false);
+	for (int roomIdx : m_ShortestPath)
+	{
+		m_IsOnShortestPath[roomIdx] = true;
+	}
 }
 
-const std::vector<int>& Dungeon::GetRoomConnectionsFromIndex(int roomIdx) const
+bool Dungeon::IsOnShortestPath(int roomIdx) const
 {
-	return m_Rooms[roomIdx].GetConnections();
+	return roomIdx < static_cast<int>(m_IsOnShortestPath.size()) && m_IsOnShortestPath[roomIdx];
 }
 
 bool Dungeon::IsRoomLocked(int roomIdx) const
@@ -89,22 +168,39 @@ bool Dungeon::IsRoomLocked(int roomIdx) const
 	return m_Rooms[roomIdx].GetRoomType() == DungeonRoom::DungeonRoomType::LockedRoom;
 }
 
-bool Dungeon::IsSolved() const
+#ifndef DUNGEON_HEADLESS
+void Dungeon::Draw() const
 {
-	for (const DungeonRoom& room : m_Rooms)
+	if (m_Generator.IsDone())
 	{
-		if (room.GetRoomType() == DungeonRoom::DungeonRoomType::KeyRoom) return false;
-		if (room.GetRoomType() == DungeonRoom::DungeonRoomType::LockedRoom) return false;
-	}
-	return true;
-}
+		// The rooms don't move anymore, so they are only added to the draw grid once
+		if (m_IsDrawGridDirty)
+		{
+			// Big cells, so a zoomed out camera doesn't have to visit too many cells
+			constexpr int drawCellSize{ 256 };
 
-void Dungeon::Draw() const
-{
-	// Draw every room
-	for (const DungeonRoom& room : m_Rooms)
+			m_IsDrawGridDirty = false;
+			m_DrawGrid.SetCellSize(drawCellSize);
+			m_DrawGrid.Clear();
+			for (int roomIdx{}; roomIdx < static_cast<int>(m_Rooms.size()); ++roomIdx)
+			{
+				m_DrawGrid.Insert(roomIdx, m_Rooms[roomIdx].GetPosition(), m_Rooms[roomIdx].GetSize());
+			}
+		}
+
+		// Draw the rooms on screen, in the order they are stored so the rooms of the same color stay together
+		Vector2 visiblePosition{};
+		Vector2 visibleSize{};
+		CAMERA->GetVisibleArea(visiblePosition, visibleSize);
+		m_DrawGrid.Query(visiblePosition, visibleSize, m_VisibleRooms);
+		std::sort(m_VisibleRooms.begin(), m_VisibleRooms.end());
+
+		DungeonRoom::DrawRooms(m_Rooms, m_VisibleRooms);
+	}
+	else
 	{
-		room.Draw();
+		// Rooms still move every step, test every room
+		DungeonRoom::DrawRooms(m_Rooms);
 	}
 
 	// If generation is still busy, draw debug
@@ -113,138 +209,124 @@ void Dungeon::Draw() const
 		m_Generator.DrawDebug();
 	}
 }
+#endif
+
+void Dungeon::PlaceKeys()
+{
+	const std::chrono::steady_clock::time_point keyPlacementStart{ std::chrono::steady_clock::now() };
+	GenerateKeysAndLockedRooms();
+	m_KeyPlacementSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - keyPlacementStart).count();
+}
 
 void Dungeon::GenerateKeysAndLockedRooms()
 {
-	// Create a solver for the dungeon
-	DungeonSolver solver{ shared_from_this() };
-	solver.SetNeedAllKeys(m_NeedAllKeys);
+	// Every container of the previous key placement has been destroyed, so its memory can be used again
+	m_Arena.Reset();
 
-	// Solve the empty dungeon, this calculates the shortest path to complete the dungeon without keys and doors
-	solver.Solve(true);
+	// Find the path from the start to the end, this is the shortest path to complete the dungeon without keys and doors
+	KeyPlacer placer{ m_Rooms, m_Connections, GetStartRoom(), GetEndRoom(), m_Arena };
+	SetShortestPath(placer.GetPath());
 
-	// Find the start and end room
-	const int startIdx{ GetStartRoom() };
-	const int endIdx{ GetEndRoom() };
+	// Key and locked rooms are picked with the random generator of this dungeon, this keeps the dungeon reproducable from its seed
+	RandomGenerator& random{ m_Generator.GetRandomGenerator() };
 
 	// Rooms that have keys and doors
-	std::vector<int> keyRooms{};
-	std::vector<int> lockedRooms{};
-
-	// Get the number of leaf rooms (only 1 connection) in the dungeon
-	int nrLeafRooms{};
-	for (const DungeonRoom& room : m_Rooms)
+	ArenaVector<int> keyRooms{ m_Arena };
+	ArenaVector<int> lockedRooms{ m_Arena };
+	if (m_NrKeys > 0)
 	{
-		if (room.GetConnections().size() == 1) ++nrLeafRooms;
+		keyRooms.reserve(m_NrKeys);
+		lockedRooms.reserve(m_NrKeys);
 	}
 
-	// Remove the start and end rooms
-	nrLeafRooms -= 2;
-
-	// Keep a counter so there won't be an infinite while loop
-	int tries{};
-	constexpr int maxTries{ 100 };
+	// Place the keys and locked rooms so that the dungeon can always be solved
+	placer.Place(random, m_NrKeys, m_NeedAllKeys, keyRooms, lockedRooms);
 
-	// For every key
-	for (int i{}; i < m_NrKeys; ++i)
+	// Spawn the locks and keys, and report them to the listener of the generator
+	GenerationListener* pListener{ m_Generator.GetListener() };
+	for (int roomIdx : keyRooms)
 	{
-		// The indices of the rooms that will be added to the key rooms container and the locked rooms container
-		int keyRoomIdx{ -1 };
-		int doorRoomIdx{ -1 };
-
-		// Spawn a key and a locked room, while the dungeon cannot be solved
-		do
-		{
-			++tries;
-
-			// Reset the previous key and locked room if there were any
-			if (keyRoomIdx >= 0) m_Rooms[keyRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::Room);
-			if (doorRoomIdx >= 0) m_Rooms[doorRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::Room);
-
-			// If the max tries have been hit, stop the loop
-			if (tries > maxTries) break;
-
-			// Reset the key and the lock in the already found key rooms and locked rooms
-			for (int roomIdx : keyRooms)
-			{
-				m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::KeyRoom);
-			}
-			for (int roomIdx : lockedRooms)
-			{
-				m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::LockedRoom);
-			}
-
-			// Find a room that is not the start or the end, and the room is a leaf room if there are still leaf rooms available
-			int curKeyRoomIdx{};
-			do
-			{
-				curKeyRoomIdx = rand() % m_Rooms.size();
-			} while (m_Rooms[curKeyRoomIdx].GetRoomType() != DungeonRoom::DungeonRoomType::Room ||
-				curKeyRoomIdx == startIdx ||
-				curKeyRoomIdx == endIdx ||
-				(m_NeedAllKeys && tries < maxTries / 2 && keyRooms.size() < nrLeafRooms && m_Rooms[curKeyRoomIdx].GetConnections().size() > 1));
-
-			// Save the current key room index and set the room type to a KeyRoom
-			keyRoomIdx = curKeyRoomIdx;
-			m_Rooms[curKeyRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::KeyRoom);
-
-			// Find a room that is not the start or the end, and the room is not a leaf room
-			int curDoorRoomIdx{};
-			do
-			{
-				curDoorRoomIdx = rand() % m_Rooms.size();
-			} while (m_Rooms[curDoorRoomIdx].GetRoomType() != DungeonRoom::DungeonRoomType::Room ||
-				curDoorRoomIdx == startIdx ||
-				curDoorRoomIdx == endIdx ||
-				m_Rooms[curDoorRoomIdx].GetConnections().size() == 1);
-
-			// Save the current locked room index and set the room type to a LockedRoom
-			doorRoomIdx = curDoorRoomIdx;
-			m_Rooms[curDoorRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::LockedRoom);
-
-			// Can the current dungeon be solved
-			bool solveable{ solver.Solve() };
-
-			// If the dungeon can not be solved, swap the key and locked room and try again
-			if (!solveable)
-			{
-				if (m_Rooms[curKeyRoomIdx].GetConnections().size() > 1)
-				{
-					curKeyRoomIdx = curDoorRoomIdx;
-					curDoorRoomIdx = keyRoomIdx;
-				}
-				keyRoomIdx = curKeyRoomIdx;
-				doorRoomIdx = curDoorRoomIdx;
-				m_Rooms[curKeyRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::KeyRoom);
-				m_Rooms[curDoorRoomIdx].SetRoomType(DungeonRoom::DungeonRoomType::LockedRoom);
-
-				for (int roomIdx : keyRooms)
-				{
-					m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::KeyRoom);
-				}
-				for (int roomIdx : lockedRooms)
-				{
-					m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::LockedRoom);
-				}
-			}
-
-		} while (!solver.Solve());
+		SetRoomType(roomIdx, DungeonRoom::DungeonRoomType::KeyRoom);
+		if (pListener) pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::KeyPlaced, roomIdx });
+	}
+	for (int roomIdx : lockedRooms)
+	{
+		SetRoomType(roomIdx, DungeonRoom::DungeonRoomType::LockedRoom);
+		if (pListener) pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::LockedRoomPlaced, roomIdx });
+	}
+}
 
-		// If the max tries have been hit, stop the loop
-		if (tries > maxTries) break;
+void Dungeon::IndexRooms()
+{
+	m_StartRoomIdx = -1;
+	m_EndRoomIdx = -1;
+	m_NrKeyRooms = 0;
+	m_NrLockedRooms = 0;
 
-		// Add the found key and locked room to the list of key and locked rooms
-		keyRooms.push_back(keyRoomIdx);
-		lockedRooms.push_back(doorRoomIdx);
+	for (int i{}; i < static_cast<int>(m_Rooms.size()); ++i)
+	{
+		switch (m_Rooms[i].GetRoomType())
+		{
+		case DungeonRoom::DungeonRoomType::Start:
+			m_StartRoomIdx = i;
+			break;
+		case DungeonRoom::DungeonRoomType::End:
+			m_EndRoomIdx = i;
+			break;
+		case DungeonRoom::DungeonRoomType::KeyRoom:
+			++m_NrKeyRooms;
+			break;
+		case DungeonRoom::DungeonRoomType::LockedRoom:
+			++m_NrLockedRooms;
+			break;
+		default:
+			break;
+		}
 	}
+}
 
-	// Respawn the locks and keys
-	for (int roomIdx : keyRooms)
+void Dungeon::SetRoomType(int roomIdx, DungeonRoom::DungeonRoomType roomType)
+{
+	DungeonRoom& room{ m_Rooms[roomIdx] };
+
+	// Forget the previous type of the room
+	switch (room.GetRoomType())
 	{
-		m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::KeyRoom);
+	case DungeonRoom::DungeonRoomType::Start:
+		m_StartRoomIdx = -1;
+		break;
+	case DungeonRoom::DungeonRoomType::End:
+		m_EndRoomIdx = -1;
+		break;
+	case DungeonRoom::DungeonRoomType::KeyRoom:
+		--m_NrKeyRooms;
+		break;
+	case DungeonRoom::DungeonRoomType::LockedRoom:
+		--m_NrLockedRooms;
+		break;
+	default:
+		break;
 	}
-	for (int roomIdx : lockedRooms)
+
+	room.SetRoomType(roomType);
+	++m_DrawVersion;
+
+	// Remember the new type of the room
+	switch (roomType)
 	{
-		m_Rooms[roomIdx].SetRoomType(DungeonRoom::DungeonRoomType::LockedRoom);
+	case DungeonRoom::DungeonRoomType::Start:
+		m_StartRoomIdx = roomIdx;
+		break;
+	case DungeonRoom::DungeonRoomType::End:
+		m_EndRoomIdx = roomIdx;
+		break;
+	case DungeonRoom::DungeonRoomType::KeyRoom:
+		++m_NrKeyRooms;
+		break;
+	case DungeonRoom::DungeonRoomType::LockedRoom:
+		++m_NrLockedRooms;
+		break;
+	default:
+		break;
 	}
 }
@@ -5,7 +5,10 @@
 //-----------------------------------------------------
 #include "DungeonRoom.h"
 #include "DungeonGenerator.h"
+#include "SpatialHashGrid.h"
+#include "GenerationArena.h"
 #include <vector>
+#include <memory>
 
 //-----------------------------------------------------
 // Dungeon Class									
@@ -13,6 +16,17 @@
 class Dungeon final : public std::enable_shared_from_this<Dungeon>
 {
 public:
+	// The result of placing an amount of keys in the layout of the dungeon
+	struct KeySweepResult
+	{
+		int nrKeys{};
+		int nrPlacedKeys{};
+		bool isSolved{};
+		// The amount of rooms the solver walked through, including the rooms it walked back through
+		int nrSolveSteps{};
+		double keyPlacementSeconds{};
+	};
+
 	Dungeon() = default;	// Constructor
 	~Dungeon() = default;	// Destructor
 
@@ -30,25 +44,54 @@ public:
 	void GenerateDungeon();
 	void Update();
 	void SetKeyCount(int count) { m_NrKeys = count; }
+	int GetKeyCount() const { return m_NrKeys; }
 	DungeonGenerator& GetGenerator() { return m_Generator; }
+	const DungeonGenerator& GetGenerator() const { return m_Generator; }
 	bool PickUpKeyInRoom(int roomIdx);
 	bool UseKeyInRoom(int roomIdx);
 	void SetNeedAllKeys(bool needAllKeys);
+	bool GetNeedAllKeys() const { return m_NeedAllKeys; }
+
+	// Whether the finished layout of this dungeon is the layout these settings would create
+	bool HasLayout(const DungeonGenerator::LayoutSettings& settings) const;
+	// Places the keys and locked rooms again with the current key settings, without generating the layout again
+	void RegenerateKeys();
+	// Places every amount of keys from firstNrKeys up to lastNrKeys in the finished layout and solves the dungeon for each of them
+	// The dungeon has to be owned by a shared_ptr, like every dungeon a solver solves, the keys of the current key settings are placed afterwards
+	void SweepKeyCounts(int firstNrKeys, int lastNrKeys, std::vector<KeySweepResult>& results);
 
-	int GetStartRoom() const;
-	int GetEndRoom() const;
+	int GetStartRoom() const { return m_StartRoomIdx; }
+	int GetEndRoom() const { return m_EndRoomIdx; }
 	Vector2 GetRoomPositionFromIndex(int roomIdx) const;
-	const std::vector<int>& GetRoomConnectionsFromIndex(int roomIdx) const;
+	IndexRange GetRoomConnectionsFromIndex(int roomIdx) const;
 	bool IsRoomLocked(int roomIdx) const;
-	bool IsSolved() const;
+	bool IsSolved() const { return m_NrKeyRooms == 0 && m_NrLockedRooms == 0; }
+	double GetKeyPlacementTime() const { return m_KeyPlacementSeconds; }
+	const std::vector<DungeonRoom>& GetRooms() const { return m_Rooms; }
+	const AdjacencyList& GetConnections() const { return m_Connections; }
+
+	// Changes every time the dungeon is regenerated or the type of a room changes
+	int GetDrawVersion() const { return m_DrawVersion; }
+
+	// The memory of the scratch data of key placement, reset every time keys are placed
+	const GenerationArena& GetArena() const { return m_Arena; }
+
+	void SetShortestPath(IndexRange shortestPath);
+	const std::vector<int>& GetShortestPath() const { return m_ShortestPath; }
+	bool IsOnShortestPath(int roomIdx) const;
 
+#ifndef DUNGEON_HEADLESS
 	void Draw() const;
+#endif
 
 private:
 	//-------------------------------------------------
 	// Private member functions								
 	//-------------------------------------------------
 	void GenerateKeysAndLockedRooms();
+	void PlaceKeys();
+	void IndexRooms();
+	void SetRoomType(int roomIdx, DungeonRoom::DungeonRoomType roomType);
 
 	//-------------------------------------------------
 	// Datamembers								
@@ -56,7 +99,35 @@ private:
 	DungeonGenerator m_Generator{};
 
 	std::vector<DungeonRoom> m_Rooms{};
+	AdjacencyList m_Connections{};
+
+	// The start and end room and the amount of keys and doors left, kept up to date every time a room type changes
+	int m_StartRoomIdx{ -1 };
+	int m_EndRoomIdx{ -1 };
+	int m_NrKeyRooms{};
+	int m_NrLockedRooms{};
+
+	// The rooms from the start to the end without keys and doors, every solver of this dungeon only reads it
+	std::vector<int> m_ShortestPath{};
+	std::vector<bool> m_IsOnShortestPath{};
 	bool m_HasAddedKeys{};
 	int m_NrKeys{};
 	bool m_NeedAllKeys{};
+	double m_KeyPlacementSeconds{};
+	int m_DrawVersion{};
+
+	// Kept with the dungeon, so a reused dungeon places its keys without allocating
+	GenerationArena m_Arena{};
+
+	// The settings of the finished layout and the random generator right after it, to place other keys in the same layout
+	DungeonGenerator::LayoutSettings m_LayoutSettings{};
+	uint64_t m_LayoutRandomState{};
+	bool m_HasLayout{};
+
+#ifndef DUNGEON_HEADLESS
+	// The rooms of a finished dungeon, so only the rooms on screen are drawn
+	mutable SpatialHashGrid m_DrawGrid{};
+	mutable std::vector<int> m_VisibleRooms{};
+	mutable bool m_IsDrawGridDirty{ true };
+#endif
 };
@@ -0,0 +1,239 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "DungeonBatchGenerator.h"
+
+//---------------------------
+// Constructor & Destructor
+//---------------------------
+DungeonBatchGenerator::DungeonBatchGenerator(const DungeonParameters& parameters, int nrThreads)
+	: m_Parameters{ parameters }
+	, m_NrThreads{ nrThreads > 0 ? nrThreads : static_cast<int>(std::thread::hardware_concurrency()) }
+{
+	// hardware_concurrency can return 0 if it is unknown
+	if (m_NrThreads <= 0) m_NrThreads = 1;
+
+	// Keep a few dungeons per thread in flight, so a slow seed doesn't make the other threads wait immediately
+	m_WindowSize = m_NrThreads * 4;
+
+	for (int i{}; i < m_NrThreads; ++i)
+	{
+		m_Queues.push_back(std::make_unique<WorkerQueue>());
+	}
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void DungeonBatchGenerator::Generate(int firstSeed, int lastSeed, const DungeonCallback& callback)
+{
+	// The amount of seeds is calculated in 64 bit, the range from INT_MIN to INT_MAX doesn't fit in an int
+	m_pSeeds = nullptr;
+	m_FirstSeed = firstSeed;
+	GenerateSeeds(lastSeed >= firstSeed ? static_cast<long long>(lastSeed) - firstSeed + 1 : 0, callback);
+}
+
+void DungeonBatchGenerator::Generate(const std::vector<int>& seeds, const DungeonCallback& callback)
+{
+	m_pSeeds = &seeds;
+	m_FirstSeed = 0;
+	GenerateSeeds(static_cast<long long>(seeds.size()), callback);
+}
+
+void DungeonBatchGenerator::GenerateSeeds(long long nrSeeds, const DungeonCallback& callback)
+{
+	// Reset the results
+	m_NrSeeds = nrSeeds;
+	m_Results.assign(m_WindowSize, nullptr);
+	m_NextResultIdx = 0;
+	m_NrDealtSeeds = 0;
+	m_IsStopping = false;
+
+	// Deal the seeds of the first window out to the workers one by one, the front of every queue is always close to the next result
+	for (long long i{}; i < m_WindowSize && i < nrSeeds; ++i)
+	{
+		DealSeedIndex(i);
+	}
+
+	// Start the workers
+	std::vector<std::thread> workers{};
+	workers.reserve(m_NrThreads);
+	try
+	{
+		for (int i{}; i < m_NrThreads; ++i)
+		{
+			workers.emplace_back(&DungeonBatchGenerator::RunWorker, this, i);
+		}
+
+		// Pass every dungeon to the callback in the order of the seeds
+		for (long long i{}; i < nrSeeds; ++i)
+		{
+			std::shared_ptr<Dungeon>& pResult{ m_Results[i % m_WindowSize] };
+
+			std::shared_ptr<Dungeon> pDungeon{};
+			{
+				std::unique_lock<std::mutex> lock{ m_ResultMutex };
+				m_ResultCondition.wait(lock, [&]() { return pResult != nullptr; });
+				pDungeon = std::move(pResult);
+			}
+
+			callback(GetSeed(i), *pDungeon);
+
+			// Give the dungeon back to the workers, move the window and deal out the seed that entered the window
+			{
+				std::lock_guard<std::mutex> lock{ m_ResultMutex };
+				m_FreeDungeons.push_back(std::move(pDungeon));
+				if (i + m_WindowSize < nrSeeds) DealSeedIndex(i + m_WindowSize);
+				++m_NextResultIdx;
+			}
+			m_WindowCondition.notify_all();
+		}
+	}
+	catch (...)
+	{
+		// Joinable threads can't be destroyed, stop the workers before the exception leaves this function
+		StopWorkers(workers);
+		throw;
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+int DungeonBatchGenerator::GetSeed(long long seedIdx) const
+{
+	if (m_pSeeds) return (*m_pSeeds)[seedIdx];
+
+	// The index never goes past the last seed, so the seed fits in an int
+	return static_cast<int>(m_FirstSeed + seedIdx);
+}
+
+void DungeonBatchGenerator::DealSeedIndex(long long seedIdx)
+{
+	{
+		WorkerQueue& queue{ *m_Queues[seedIdx % m_NrThreads] };
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		queue.seedIndices.push_back(seedIdx);
+	}
+
+	// Only count the seed once it is in a queue, a worker that sees every seed dealt and every queue empty can stop
+	++m_NrDealtSeeds;
+}
+
+void DungeonBatchGenerator::StopWorkers(std::vector<std::thread>& workers)
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_ResultMutex };
+		m_IsStopping = true;
+	}
+	m_WindowCondition.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	// Throw away the seeds that are left and keep the containers of the unused results for the next batch
+	for (const std::unique_ptr<WorkerQueue>& pQueue : m_Queues)
+	{
+		pQueue->seedIndices.clear();
+	}
+	for (std::shared_ptr<Dungeon>& pResult : m_Results)
+	{
+		if (pResult) m_FreeDungeons.push_back(std::move(pResult));
+	}
+}
+
+void DungeonBatchGenerator::RunWorker(int workerIdx)
+{
+	long long seedIdx{};
+
+	// As long as there are seeds left
+	while (TakeSeedIndex(workerIdx, seedIdx))
+	{
+		// Get a dungeon that is not in use
+		const std::shared_ptr<Dungeon> pDungeon{ AcquireDungeon() };
+
+		// Apply the parameters, the dungeon might have been used with other parameters before
+		DungeonGenerator& generator{ pDungeon->GetGenerator() };
+		generator.SetSeed(GetSeed(seedIdx));
+		generator.SetInitialRadius(m_Parameters.initRadius);
+		generator.SetInitialRoomCount(m_Parameters.initRoomCount);
+		generator.SetRoomSizeBounds(m_Parameters.roomSizeBounds.x, m_Parameters.roomSizeBounds.y);
+		generator.SetRoomSizeThreshold(m_Parameters.roomSizeThreshold);
+		generator.SetGenerationState(false);
+		generator.SetLongestPathState(m_Parameters.isUsingLongestPath);
+		generator.SetSeperationMode(m_Parameters.seperationMode);
+		pDungeon->SetKeyCount(m_Parameters.nrKeys);
+		pDungeon->SetNeedAllKeys(m_Parameters.needAllKeys);
+
+		// Generate the layout
+		pDungeon->GenerateDungeon();
+
+		// Place the keys and locked rooms
+		pDungeon->Update();
+
+		// Publish the dungeon
+		{
+			std::lock_guard<std::mutex> lock{ m_ResultMutex };
+			m_Results[seedIdx % m_WindowSize] = pDungeon;
+		}
+		m_ResultCondition.notify_one();
+	}
+}
+
+bool DungeonBatchGenerator::TakeSeedIndex(int workerIdx, long long& seedIdx)
+{
+	while (true)
+	{
+		// If the batch has been stopped, stop the worker
+		if (m_IsStopping) return false;
+
+		// Only seeds inside the window are dealt out, this limits the amount of finished dungeons waiting for the callback
+		const long long nextResultIdx{ m_NextResultIdx };
+		const bool isEverySeedDealt{ m_NrDealtSeeds == m_NrSeeds };
+
+		// Take the next seed of the own queue first, if it is empty steal from the other workers
+		for (int i{}; i < m_NrThreads; ++i)
+		{
+			if (TakeFromQueue(*m_Queues[(workerIdx + i) % m_NrThreads], seedIdx)) return true;
+		}
+
+		// If there are no seeds left, stop the worker
+		if (isEverySeedDealt) return false;
+
+		// Wait until the window moves
+		std::unique_lock<std::mutex> lock{ m_ResultMutex };
+		m_WindowCondition.wait(lock, [&]() { return m_NextResultIdx != nextResultIdx || m_IsStopping; });
+	}
+}
+
+bool DungeonBatchGenerator::TakeFromQueue(WorkerQueue& queue, long long& seedIdx)
+{
+	std::lock_guard<std::mutex> lock{ queue.mutex };
+
+	if (queue.seedIndices.empty()) return false;
+
+	// Stealing also happens from the front, the oldest seed is the one the callback is waiting for
+	seedIdx = queue.seedIndices.front();
+	queue.seedIndices.pop_front();
+	return true;
+}
+
+std::shared_ptr<Dungeon> DungeonBatchGenerator::AcquireDungeon()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_ResultMutex };
+		if (!m_FreeDungeons.empty())
+		{
+			std::shared_ptr<Dungeon> pDungeon{ std::move(m_FreeDungeons.back()) };
+			m_FreeDungeons.pop_back();
+			return pDungeon;
+		}
+	}
+
+	// There are never more dungeons than the window size, so this only happens at the start of the first batch
+	return std::make_shared<Dungeon>();
+}
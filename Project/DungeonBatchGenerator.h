@@ -0,0 +1,111 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include "Dungeon.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+//-----------------------------------------------------
+// DungeonParameters Struct
+//-----------------------------------------------------
+// Every parameter needed to generate a dungeon, next to its seed
+struct DungeonParameters
+{
+	int initRadius{ 100 };
+	int initRoomCount{ 200 };
+	Vector2 roomSizeBounds{ 4, 40 };
+	int roomSizeThreshold{ 30 };
+	int nrKeys{ 0 };
+	bool needAllKeys{ true };
+	bool isUsingLongestPath{ false };
+	DungeonGenerator::SeperationMode seperationMode{ DungeonGenerator::SeperationMode::Steering };
+};
+
+//-----------------------------------------------------
+// DungeonBatchGenerator Class
+//-----------------------------------------------------
+class DungeonBatchGenerator final
+{
+public:
+	// Called on the thread that called Generate, in the same order as the seeds
+	using DungeonCallback = std::function<void(int seed, const Dungeon& dungeon)>;
+
+	explicit DungeonBatchGenerator(const DungeonParameters& parameters, int nrThreads = 0);	// Constructor
+	~DungeonBatchGenerator() = default;															// Destructor
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	DungeonBatchGenerator(const DungeonBatchGenerator& other) = delete;
+	DungeonBatchGenerator(DungeonBatchGenerator&& other) noexcept = delete;
+	DungeonBatchGenerator& operator=(const DungeonBatchGenerator& other) = delete;
+	DungeonBatchGenerator& operator=(DungeonBatchGenerator&& other) noexcept = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	void Generate(int firstSeed, int lastSeed, const DungeonCallback& callback);
+	void Generate(const std::vector<int>& seeds, const DungeonCallback& callback);
+
+	void SetParameters(const DungeonParameters& parameters) { m_Parameters = parameters; }
+	const DungeonParameters& GetParameters() const { return m_Parameters; }
+	int GetThreadCount() const { return m_NrThreads; }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	struct WorkerQueue
+	{
+		std::mutex mutex{};
+		std::deque<long long> seedIndices{};
+	};
+
+	void GenerateSeeds(long long nrSeeds, const DungeonCallback& callback);
+	int GetSeed(long long seedIdx) const;
+	void DealSeedIndex(long long seedIdx);
+	void StopWorkers(std::vector<std::thread>& workers);
+	void RunWorker(int workerIdx);
+	bool TakeSeedIndex(int workerIdx, long long& seedIdx);
+	bool TakeFromQueue(WorkerQueue& queue, long long& seedIdx);
+	std::shared_ptr<Dungeon> AcquireDungeon();
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	DungeonParameters m_Parameters{};
+	int m_NrThreads{};
+
+	// The seeds of the current batch, either the listed seeds or every seed from the first seed on
+	const std::vector<int>* m_pSeeds{};
+	long long m_FirstSeed{};
+	long long m_NrSeeds{};
+
+	// The seeds inside the window every worker still has to generate, idle workers steal from other workers
+	// Seeds are only dealt out when they enter the window, so a huge range of seeds is never stored
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues{};
+	std::atomic<long long> m_NrDealtSeeds{};
+
+	// Finished dungeons waiting to be passed to the callback, only seeds inside the window after the next result are generated
+	// Every seed inside the window has its own slot, the slot of a seed is its index modulo the window size
+	std::mutex m_ResultMutex{};
+	std::condition_variable m_ResultCondition{};
+	std::condition_variable m_WindowCondition{};
+	std::vector<std::shared_ptr<Dungeon>> m_Results{};
+	std::atomic<long long> m_NextResultIdx{};
+	int m_WindowSize{};
+
+	// Set when the callback throws, the workers stop after the dungeon they are generating
+	std::atomic<bool> m_IsStopping{};
+
+	// Dungeons that have been passed to the callback, their containers are reused for the next seeds
+	std::vector<std::shared_ptr<Dungeon>> m_FreeDungeons{};
+};
@@ -0,0 +1,372 @@
+//-----------------------------------------------------------------
+// Generation benchmark
+// Generates a fixed set of configurations over many seeds and reports the time of every stage as CSV
+//-----------------------------------------------------------------
+
+//---------------------------
+// Includes
+//---------------------------
+#include "Dungeon.h"
+#include "GenerationEventQueue.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+//---------------------------
+// Parameters
+//---------------------------
+struct BenchmarkConfiguration
+{
+	const char* name{};
+	int initRoomCount{};
+	int initRadius{};
+	Vector2 roomSizeBounds{};
+	int nrKeys{};
+};
+
+struct BenchmarkParameters
+{
+	int firstSeed{ 0 };
+	int nrSeeds{ 100 };
+	bool isPrintingEverySeed{};
+	bool isUsingBroadphase{ true };
+	bool isReadingEvents{};
+	DungeonGenerator::SeperationMode seperationMode{ DungeonGenerator::SeperationMode::Steering };
+	RoomKernel::InstructionSet instructionSet{ RoomKernel::InstructionSet::AVX2 };
+	std::string outputPath{};
+};
+
+// The measurements of one or more seeds
+struct BenchmarkResult
+{
+	int nrSeeds{};
+	double stageSeconds[static_cast<int>(DungeonGenerator::GenerationCycleState::DONE)]{};
+	double keyPlacementSeconds{};
+	double totalSeconds{};
+	double maxTotalSeconds{};
+	long long nrSeperationIterations{};
+	long long nrRetries{};
+	long long nrBlockedCorridors{};
+	long long nrRooms{};
+	long long nrArenaAllocations{};
+	int nrArenaBlocks{};
+};
+
+// What a reader on another thread rebuilt from the generation events
+struct EventReplay
+{
+	long long nrEvents{};
+	std::vector<int> finishedRoomCounts{};
+};
+
+// The fixed set of configurations, changing these makes the results incomparable with older versions
+constexpr BenchmarkConfiguration g_Configurations[]
+{
+	{ "small", 100, 50, { 4, 40 }, 0 },
+	{ "default", 200, 100, { 4, 40 }, 3 },
+	{ "big_rooms", 200, 100, { 10, 60 }, 3 },
+	{ "large", 1000, 300, { 4, 40 }, 5 },
+	{ "huge", 2000, 420, { 4, 40 }, 0 }
+};
+
+//---------------------------
+// Functions
+//---------------------------
+void PrintUsage()
+{
+	std::cerr
+		<< "Usage: GPP_Research_DungeonBenchmark [options]\n"
+		<< "  --seeds <count>                     Amount of seeds per configuration (default 100)\n"
+		<< "  --first-seed <seed>                 The first seed of every configuration (default 0)\n"
+		<< "  --per-seed                          Write a line for every seed instead of one per configuration\n"
+		<< "  --brute-force                       Seperate rooms without the broadphase\n"
+		<< "  --events                            Stream the generation events to a reader thread and check that it can follow\n"
+		<< "  --instruction-set <scalar|sse41|avx2>  Widest instruction set of the room kernels (default avx2)\n"
+		<< "  --seperation <steering|mtv>         How overlapping rooms are pushed apart (default steering)\n"
+		<< "  --output <file>                     File to write the results to (default standard output)\n";
+}
+
+bool ReadParameters(int argc, char* argv[], BenchmarkParameters& parameters)
+{
+	try
+	{
+		for (int i{ 1 }; i < argc; ++i)
+		{
+			const std::string argument{ argv[i] };
+
+			if (argument == "--per-seed")
+			{
+				parameters.isPrintingEverySeed = true;
+				continue;
+			}
+			if (argument == "--brute-force")
+			{
+				parameters.isUsingBroadphase = false;
+				continue;
+			}
+			if (argument == "--events")
+			{
+				parameters.isReadingEvents = true;
+				continue;
+			}
+
+			// Every other argument is followed by a value
+			if (i + 1 >= argc) return false;
+			const std::string value{ argv[++i] };
+
+			if (argument == "--seeds")
+			{
+				parameters.nrSeeds = std::stoi(value);
+			}
+			else if (argument == "--first-seed")
+			{
+				parameters.firstSeed = std::stoi(value);
+			}
+			else if (argument == "--instruction-set")
+			{
+				if (value == "scalar") parameters.instructionSet = RoomKernel::InstructionSet::Scalar;
+				else if (value == "sse41") parameters.instructionSet = RoomKernel::InstructionSet::SSE41;
+				else if (value == "avx2") parameters.instructionSet = RoomKernel::InstructionSet::AVX2;
+				else return false;
+			}
+			else if (argument == "--seperation")
+			{
+				if (value == "steering") parameters.seperationMode = DungeonGenerator::SeperationMode::Steering;
+				else if (value == "mtv") parameters.seperationMode = DungeonGenerator::SeperationMode::MinimumTranslation;
+				else return false;
+			}
+			else if (argument == "--output")
+			{
+				parameters.outputPath = value;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+	catch (const std::logic_error&)
+	{
+		// One of the values is not a number
+		return false;
+	}
+
+	// Negative seeds would use the current time, which makes the results incomparable
+	return parameters.firstSeed >= 0 && parameters.nrSeeds > 0;
+}
+
+void WriteHeader(std::ostream& output, bool isPrintingEverySeed)
+{
+	output << "configuration,rooms,radius,min_size,max_size,keys,instruction_set,broadphase,seperation," << (isPrintingEverySeed ? "seed" : "seeds");
+
+	// The average time of every stage in milliseconds
+	for (int stage{}; stage < static_cast<int>(DungeonGenerator::GenerationCycleState::DONE); ++stage)
+	{
+		output << ',' << DungeonGenerator::GetStageName(static_cast<DungeonGenerator::GenerationCycleState>(stage)) << "_ms";
+	}
+
+	output << ",KEY_PLACEMENT_ms,total_ms,max_total_ms,seperation_iterations,retries,blocked_corridors,final_rooms,arena_allocations,arena_blocks\n";
+}
+
+void WriteResult(std::ostream& output, const BenchmarkConfiguration& configuration, const Dungeon& dungeon, bool isUsingBroadphase, int seed, const BenchmarkResult& result)
+{
+	const DungeonGenerator& generator{ dungeon.GetGenerator() };
+
+	// Every value is an average per seed, except for the amount of retries, blocked corridors and arena blocks
+	const double nrSeeds{ static_cast<double>(result.nrSeeds) };
+
+	output << configuration.name << ',' << configuration.initRoomCount << ',' << configuration.initRadius << ','
+		<< configuration.roomSizeBounds.x << ',' << configuration.roomSizeBounds.y << ',' << configuration.nrKeys << ','
+		<< RoomKernel::GetInstructionSetName(generator.GetInstructionSet()) << ',' << (isUsingBroadphase ? 1 : 0) << ','
+		<< (generator.GetSeperationMode() == DungeonGenerator::SeperationMode::MinimumTranslation ? "mtv" : "steering") << ','
+		<< (seed >= 0 ? seed : result.nrSeeds);
+
+	for (double stageSeconds : result.stageSeconds)
+	{
+		output << ',' << stageSeconds * 1000.0 / nrSeeds;
+	}
+
+	output << ',' << result.keyPlacementSeconds * 1000.0 / nrSeeds
+		<< ',' << result.totalSeconds * 1000.0 / nrSeeds
+		<< ',' << result.maxTotalSeconds * 1000.0
+		<< ',' << static_cast<double>(result.nrSeperationIterations) / nrSeeds
+		<< ',' << result.nrRetries
+		<< ',' << result.nrBlockedCorridors
+		<< ',' << static_cast<double>(result.nrRooms) / nrSeeds
+		<< ',' << static_cast<double>(result.nrArenaAllocations) / nrSeeds
+		<< ',' << result.nrArenaBlocks << '\n';
+}
+
+void AddMeasurements(BenchmarkResult& result, const Dungeon& dungeon, double totalSeconds)
+{
+	const DungeonGenerator::GenerationStatistics& statistics{ dungeon.GetGenerator().GetStatistics() };
+
+	++result.nrSeeds;
+	for (int stage{}; stage < static_cast<int>(DungeonGenerator::GenerationCycleState::DONE); ++stage)
+	{
+		result.stageSeconds[stage] += statistics.stageSeconds[stage];
+	}
+	result.keyPlacementSeconds += dungeon.GetKeyPlacementTime();
+	result.totalSeconds += totalSeconds;
+	result.maxTotalSeconds = max(result.maxTotalSeconds, totalSeconds);
+	result.nrSeperationIterations += statistics.nrSeperationIterations;
+	result.nrRetries += statistics.nrRetries;
+	result.nrBlockedCorridors += statistics.nrBlockedCorridors;
+	result.nrRooms += static_cast<long long>(dungeon.GetRooms().size());
+
+	// Every arena allocation is a heap allocation that was saved, only the blocks of the arena come from the heap
+	result.nrArenaAllocations += dungeon.GetArena().GetAllocationCount();
+	result.nrArenaBlocks = dungeon.GetArena().GetBlockAllocationCount();
+}
+
+void ReadEvents(GenerationEventQueue& queue, const std::atomic<bool>& isGenerating, EventReplay& replay)
+{
+	// Only the amount of rooms is rebuilt, it depends on every created, discarded and removed room
+	int nrRooms{};
+	int nrDiscardedRooms{};
+
+	GenerationEvent event{};
+	while (true)
+	{
+		// Check the flag before the queue, so the events of the last seed are still read after the generation stopped
+		const bool isStillGenerating{ isGenerating.load(std::memory_order_acquire) };
+		if (!queue.Pop(event))
+		{
+			if (!isStillGenerating) return;
+
+			std::this_thread::yield();
+			continue;
+		}
+
+		++replay.nrEvents;
+		switch (event.type)
+		{
+		case GenerationEventType::GenerationStarted:
+		case GenerationEventType::RoomsCleared:
+			nrRooms = 0;
+			nrDiscardedRooms = 0;
+			break;
+		case GenerationEventType::RoomCreated:
+		case GenerationEventType::CorridorCreated:
+			nrRooms = max(nrRooms, event.index + 1);
+			break;
+		case GenerationEventType::RoomDiscarded:
+			++nrDiscardedRooms;
+			break;
+		case GenerationEventType::RoomsRemoved:
+			nrRooms -= nrDiscardedRooms;
+			nrDiscardedRooms = 0;
+			break;
+		case GenerationEventType::GenerationFinished:
+			replay.finishedRoomCounts.push_back(nrRooms);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkParameters parameters{};
+	if (!ReadParameters(argc, argv, parameters))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	// Open the output file, or use the standard output
+	std::ofstream outputFile{};
+	if (!parameters.outputPath.empty())
+	{
+		outputFile.open(parameters.outputPath);
+		if (!outputFile)
+		{
+			std::cerr << "Couldn't open the output file " << parameters.outputPath << '\n';
+			return 1;
+		}
+	}
+	std::ostream& output{ parameters.outputPath.empty() ? std::cout : outputFile };
+
+	WriteHeader(output, parameters.isPrintingEverySeed);
+
+	for (const BenchmarkConfiguration& configuration : g_Configurations)
+	{
+		// Create the dungeon, it is reused for every seed of this configuration
+		const std::shared_ptr<Dungeon> pDungeon{ std::make_shared<Dungeon>() };
+		DungeonGenerator& generator{ pDungeon->GetGenerator() };
+		generator.SetInitialRoomCount(configuration.initRoomCount);
+		generator.SetInitialRadius(configuration.initRadius);
+		generator.SetRoomSizeBounds(configuration.roomSizeBounds.x, configuration.roomSizeBounds.y);
+		generator.SetGenerationState(false);
+		generator.SetBroadphaseState(parameters.isUsingBroadphase);
+		generator.SetInstructionSet(parameters.instructionSet);
+		generator.SetSeperationMode(parameters.seperationMode);
+		pDungeon->SetKeyCount(configuration.nrKeys);
+		pDungeon->SetNeedAllKeys(true);
+
+		BenchmarkResult configurationResult{};
+
+		// Stream the events to a reader thread, the measured times include the cost of creating the events
+		GenerationEventQueue eventQueue{};
+		std::atomic<bool> isGenerating{ true };
+		EventReplay replay{};
+		std::vector<int> roomCounts{};
+		std::thread eventReader{};
+		if (parameters.isReadingEvents)
+		{
+			generator.SetListener(&eventQueue);
+			eventReader = std::thread{ ReadEvents, std::ref(eventQueue), std::cref(isGenerating), std::ref(replay) };
+		}
+
+		for (int seed{ parameters.firstSeed }; seed < parameters.firstSeed + parameters.nrSeeds; ++seed)
+		{
+			// Generate the layout, the first update places the keys and locked rooms
+			const std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+			generator.SetSeed(seed);
+			pDungeon->GenerateDungeon();
+			pDungeon->Update();
+			const double totalSeconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() };
+
+			roomCounts.push_back(static_cast<int>(pDungeon->GetRooms().size()));
+
+			if (parameters.isPrintingEverySeed)
+			{
+				BenchmarkResult seedResult{};
+				AddMeasurements(seedResult, *pDungeon, totalSeconds);
+				WriteResult(output, configuration, *pDungeon, parameters.isUsingBroadphase, seed, seedResult);
+			}
+
+			AddMeasurements(configurationResult, *pDungeon, totalSeconds);
+		}
+
+		if (!parameters.isPrintingEverySeed)
+		{
+			WriteResult(output, configuration, *pDungeon, parameters.isUsingBroadphase, -1, configurationResult);
+		}
+
+		if (parameters.isReadingEvents)
+		{
+			isGenerating.store(false, std::memory_order_release);
+			eventReader.join();
+			generator.SetListener(nullptr);
+
+			// Without dropped events, the reader has to end up with the rooms of every dungeon
+			int nrWrongDungeons{ static_cast<int>(roomCounts.size()) - static_cast<int>(replay.finishedRoomCounts.size()) };
+			for (size_t i{}; i < roomCounts.size() && i < replay.finishedRoomCounts.size(); ++i)
+			{
+				if (roomCounts[i] != replay.finishedRoomCounts[i]) ++nrWrongDungeons;
+			}
+
+			std::cerr << configuration.name << ": " << replay.nrEvents << " events, " << eventQueue.GetDroppedCount() << " dropped, "
+				<< nrWrongDungeons << " of " << roomCounts.size() << " dungeons replayed with a different amount of rooms\n";
+			if (eventQueue.GetDroppedCount() == 0 && nrWrongDungeons > 0) return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "DungeonGenerationThread.h"
+
+//---------------------------
+// Constructor & Destructor
+//---------------------------
+DungeonGenerationThread::~DungeonGenerationThread()
+{
+	// Don't leave the worker running after the window closed
+	Cancel();
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void DungeonGenerationThread::Generate(const std::shared_ptr<Dungeon>& pDungeon)
+{
+	// Stop the previous dungeon, only one dungeon is generated at a time
+	Cancel();
+
+	m_pDungeon = pDungeon;
+	m_IsFinished = false;
+
+	m_Thread = std::thread{ &DungeonGenerationThread::Run, this, pDungeon };
+}
+
+void DungeonGenerationThread::Cancel()
+{
+	// Stop the generation as soon as possible
+	if (m_pDungeon) m_pDungeon->GetGenerator().Cancel();
+
+	// Wait for the worker to stop, nothing else touches the dungeon after this
+	if (m_Thread.joinable()) m_Thread.join();
+
+	m_pDungeon.reset();
+}
+
+std::shared_ptr<Dungeon> DungeonGenerationThread::TakeFinishedDungeon()
+{
+	if (!m_pDungeon || !m_IsFinished) return nullptr;
+
+	// The worker is done, joining returns right away
+	m_Thread.join();
+
+	std::shared_ptr<Dungeon> pDungeon{ std::move(m_pDungeon) };
+	m_pDungeon.reset();
+	return pDungeon;
+}
+
+void DungeonGenerationThread::Run(std::shared_ptr<Dungeon> pDungeon)
+{
+	// Generate the rooms, the first update places the keys and locked rooms
+	pDungeon->GenerateDungeon();
+	if (!pDungeon->GetGenerator().IsCancelled()) pDungeon->Update();
+
+	m_IsFinished = true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include "Dungeon.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+
+//-----------------------------------------------------
+// DungeonGenerationThread Class
+//-----------------------------------------------------
+// Generates one dungeon and places its keys on a worker thread, so the window keeps responding while a big dungeon is generated
+// The dungeon is only handed back once it is finished, until then it is only touched by the worker thread
+class DungeonGenerationThread final
+{
+public:
+	DungeonGenerationThread() = default;	// Constructor
+	~DungeonGenerationThread();				// Destructor
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	DungeonGenerationThread(const DungeonGenerationThread& other) = delete;
+	DungeonGenerationThread(DungeonGenerationThread&& other) noexcept = delete;
+	DungeonGenerationThread& operator=(const DungeonGenerationThread& other) = delete;
+	DungeonGenerationThread& operator=(DungeonGenerationThread&& other) noexcept = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	// Starts generating the dungeon, a dungeon that is still being generated is cancelled and thrown away
+	void Generate(const std::shared_ptr<Dungeon>& pDungeon);
+	// Cancels and throws away the dungeon that is being generated
+	void Cancel();
+
+	// Returns the dungeon once it is finished, nullptr while it is still being generated or after it has been returned
+	std::shared_ptr<Dungeon> TakeFinishedDungeon();
+	bool IsGenerating() const { return m_pDungeon != nullptr; }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	void Run(std::shared_ptr<Dungeon> pDungeon);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	std::thread m_Thread{};
+
+	// The dungeon that is being generated
+	std::shared_ptr<Dungeon> m_pDungeon{};
+	// Set by the worker thread once the dungeon and its keys are done
+	std::atomic<bool> m_IsFinished{};
+};
@@ -3,37 +3,50 @@
 //---------------------------
 #define _USE_MATH_DEFINES
 #include "DungeonGenerator.h"
-#include "Utils.h"
+#include <ctime>
+#include <algorithm>
+#include <climits>
+#ifndef DUNGEON_HEADLESS
 #include "Camera.h"
-#include <set>
+#endif
 
 //---------------------------
-// Constructor & Destructor
+// Member functions
 //---------------------------
-DungeonGenerator::DungeonGenerator()
-	: m_Center{ GAME_ENGINE->GetWidth() / 2, GAME_ENGINE->GetHeight() / 2 }
+void DungeonGenerator::GenerateDungeon(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
 {
+	// Reset the measurements
+	m_Statistics = GenerationStatistics{};
 
+	StartGeneration(rooms, connections);
 }
 
-//---------------------------
-// Member functions
-//---------------------------
-void DungeonGenerator::GenerateDungeon(std::vector<DungeonRoom>& rooms)
+void DungeonGenerator::StartGeneration(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
 {
-	// Apply the seed
+	// The color that the rooms should be drawn in
+	constexpr Color roomColor{ 255, 0 ,0 };
+
+	// Apply the seed, retries derive their seeds from this seed
 	if (m_CurrentSeed < 0)
 	{
-		srand(static_cast<unsigned int>(time(NULL)));
+		m_GenerationSeed = static_cast<uint64_t>(time(NULL));
 	}
 	else
 	{
-		srand(static_cast<unsigned int>(m_CurrentSeed));
+		m_GenerationSeed = static_cast<uint64_t>(m_CurrentSeed);
 	}
+	m_Random.SetSeed(m_GenerationSeed);
+	m_CurRoomSizeThreshold = m_RoomSizeThreshold;
+	m_CurSeperationPass = 0;
+
+	// Everything of the previous generation is thrown away
+	Notify(GenerationEvent{ GenerationEventType::GenerationStarted, m_CurrentSeed });
 
 	// Clear the rooms container
 	m_DebugRooms.clear();
+	m_RoomStore.Clear();
 	rooms.clear();
+	connections.Clear();
 
 	// Clear the triangulation
 	m_Triangulation.Clear();
@@ -46,6 +59,7 @@ void DungeonGenerator::GenerateDungeon(std::vector<DungeonRoom>& rooms)
 	{
 		// Reset the generation to circle generation
 		m_CurrentGenerationState = GenerationCycleState::CIRCLE;
+		m_SkipToState = GenerationCycleState::CIRCLE;
 
 		// Enable slow dungeon generation
 		m_IsGenerating = true;
@@ -55,51 +69,82 @@ void DungeonGenerator::GenerateDungeon(std::vector<DungeonRoom>& rooms)
 		// Disable slow dungeon generation
 		m_IsGenerating = false;
 
+		// The start time of the current stage
+		std::chrono::steady_clock::time_point stageStart{ std::chrono::steady_clock::now() };
+
 		// Create rooms of random sizes inside a circle
-		CreateRoomsInCircle(rooms);
+		CreateRoomsInCircle();
+		AddStageTime(GenerationCycleState::CIRCLE, stageStart);
 
 		// Seperate all the rooms so none of the rooms overlap
-		while (!SeperateRooms(rooms));
+		while (!SeperateRooms() && !m_IsCancelled);
+		AddStageTime(GenerationCycleState::SEPERATION, stageStart);
 
-		// Only keep the biggest rooms
-		DiscardSmallRooms(rooms);
+		// Discard rooms and connect the rooms that are left, until every room is connected
+		while (true)
+		{
+			// Stop between the stages if the generation has been cancelled
+			if (StopIfCancelled(rooms, connections)) return;
 
-		// Only keep rooms that are at a decent room from other rooms
-		DiscardBorderingRooms(rooms);
+			// Save the seperated rooms, a failed attempt starts again from these rooms
+			m_SeperatedRoomStore = m_RoomStore;
 
-		// If all rooms are removed
-		if (rooms.empty())
-		{
-			// Generate a new dungeon
-			GenerateDungeon(rooms);
-			return;
-		}
+			// Only keep the biggest rooms
+			DiscardSmallRooms();
+			AddStageTime(GenerationCycleState::DISCARD_SMALL_ROOMS, stageStart);
 
-		// Triangulate the dungeon
-		m_Triangulation.Triangulate(rooms);
+			// Only keep rooms that are at a decent room from other rooms
+			DiscardBorderingRooms();
+			AddStageTime(GenerationCycleState::DISCARD_BORDERING_ROOMS, stageStart);
 
-		// If no triangle is created
-		if (m_Triangulation.GetSize() < 3)
-		{
-			// Generate a new dungeon
-			GenerateDungeon(rooms);
+			// If not all rooms are removed
+			if (!m_RoomStore.IsEmpty())
+			{
+				// Create the rooms that are left
+				m_RoomStore.CreateRooms(rooms, roomColor);
+
+				// Triangulate the dungeon
+				m_Triangulation.Triangulate(rooms);
+				AddStageTime(GenerationCycleState::TRIANGULATION, stageStart);
+
+				if (m_Triangulation.GetNrTriangles() > 0)
+				{
+					// Create the minimum spanning tree from the triangulated dungeon
+					CreateMinimumSpanningTree();
+					AddStageTime(GenerationCycleState::SPANNING_TREE_ALGORITHM, stageStart);
+
+					// If the tree connects every room, the dungeon can be finished
+					if (m_MinimumSpanningTree.size() + 1 == rooms.size()) break;
+				}
+			}
+
+			// Retry the failed stages, if there are no retries left the dungeon stays empty
+			if (!RetryFailedStages(rooms)) return;
+
+			// If rooms have been added, seperate them again
+			if (m_CurrentGenerationState == GenerationCycleState::SEPERATION)
+			{
+				while (!SeperateRooms() && !m_IsCancelled);
+				AddStageTime(GenerationCycleState::SEPERATION, stageStart);
+			}
 		}
 
-		// Create the minimum spanning tree from the triangulated dungeon
-		CreateMinimumSpanningTree();
+		if (StopIfCancelled(rooms, connections)) return;
 
 		// Create corridors between the dungeon rooms
-		CreateCorridors(rooms);
+		CreateCorridors(rooms, connections);
 
 		// Choose the start and the end of the dungeon
-		ChooseBeginAndEndRoom(rooms);
+		ChooseBeginAndEndRoom(rooms, connections);
+		AddStageTime(GenerationCycleState::CORRIDORS, stageStart);
 
 		// Set the generation state to "done"
 		m_CurrentGenerationState = GenerationCycleState::DONE;
+		Notify(GenerationEvent{ GenerationEventType::GenerationFinished });
 	}
 }
 
-void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms)
+void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
 {
 	// If the dungeon is not slowly generating, do nothing
 	if (!m_IsSlowlyGenerating) return;
@@ -107,16 +152,38 @@ void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms)
 	// If the dungeon is already generated, do nothing
 	if (!m_IsGenerating) return;
 
+	// The time this update started, steps are repeated until the time budget is used
+	const std::chrono::steady_clock::time_point updateStart{ std::chrono::steady_clock::now() };
+	const std::chrono::duration<float, std::milli> timeBudget{ m_StepTimeBudget };
+
+	// Always run at least one step, stages that are skipped don't count towards the time budget
+	do
+	{
+		UpdateStep(rooms, connections);
+	} while (m_CurrentGenerationState != GenerationCycleState::DONE &&
+		(m_CurrentGenerationState < m_SkipToState || std::chrono::steady_clock::now() - updateStart < timeBudget));
+}
+
+void DungeonGenerator::UpdateStep(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
+{
+	// The color that the rooms should be drawn in
+	constexpr Color roomColor{ 255, 0 ,0 };
+
+	// The stage this step belongs to and its start time
+	const GenerationCycleState stage{ m_CurrentGenerationState };
+	std::chrono::steady_clock::time_point stageStart{ std::chrono::steady_clock::now() };
+
 	// Switch between every generation cycle state
 	switch (m_CurrentGenerationState)
 	{
 	case GenerationCycleState::CIRCLE:
 	{
 		// Generate a new room
-		CreateRoomInCircle(rooms);
+		CreateRoomInCircle();
+		rooms.push_back(m_RoomStore.CreateRoom(m_RoomStore.GetCount() - 1, roomColor));
 
 		// If the max amount of rooms is reached, switch to the seperation state
-		if (rooms.size() == m_InitRoomCount)
+		if (m_RoomStore.GetCount() == m_InitRoomCount)
 		{
 			m_CurrentGenerationState = GenerationCycleState::SEPERATION;
 		}
@@ -125,48 +192,72 @@ void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms)
 	case GenerationCycleState::SEPERATION:
 	{
 		// Seperate rooms, if all rooms are not overlapping anymore, switch to the discard rooms state
-		if (SeperateRooms(rooms))
+		const bool isEveryRoomSeperated{ SeperateRooms() };
+
+		// Show the rooms at their new position
+		m_RoomStore.CreateRooms(rooms, roomColor);
+
+		if (isEveryRoomSeperated)
 		{
+			// Save the seperated rooms, a failed attempt starts again from these rooms
+			m_SeperatedRoomStore = m_RoomStore;
+
 			m_CurrentGenerationState = GenerationCycleState::DISCARD_SMALL_ROOMS;
 		}
 		break;
 	}
 	case GenerationCycleState::DISCARD_SMALL_ROOMS:
 	{
-		// Discard small rooms, if all rooms are above the size threshold, switch to the triangulation state
-		if (DiscardSmallRooms(rooms, true))
+		// Discard every small room at once
+		DiscardSmallRooms();
+
+		// Show the rooms that are left
+		m_RoomStore.CreateRooms(rooms, roomColor);
+
+		// If all rooms are removed
+		if (m_RoomStore.IsEmpty())
 		{
-			// If all rooms are removed
-			if (rooms.empty())
-			{
-				// Generate a new dungeon
-				GenerateDungeon(rooms);
-			}
-			else
-			{
-				// If there are still rooms in the dungeon, switch to triangulation state
-				m_CurrentGenerationState = GenerationCycleState::DISCARD_BORDERING_ROOMS;
-			}
+			// Retry the failed stages, if there are no retries left the dungeon stays empty
+			RetryFailedStages(rooms);
+		}
+		else
+		{
+			// If there are still rooms in the dungeon, switch to the bordering rooms state
+			m_CurrentGenerationState = GenerationCycleState::DISCARD_BORDERING_ROOMS;
 		}
 		break;
 	}
 	case GenerationCycleState::DISCARD_BORDERING_ROOMS:
 	{
-		// Discard small rooms, if all rooms are above the size threshold, switch to the triangulation state
-		if (DiscardBorderingRooms(rooms, true))
+		// Discard every room that is too close to another room at once
+		DiscardBorderingRooms();
+
+		// Show the rooms that are left
+		m_RoomStore.CreateRooms(rooms, roomColor);
+
+		// If all rooms are removed
+		if (m_RoomStore.IsEmpty())
 		{
-			// If all rooms are removed
-			if (rooms.empty())
-			{
-				// Generate a new dungeon
-				GenerateDungeon(rooms);
-			}
-			else
+			// Retry the failed stages, if there are no retries left the dungeon stays empty
+			RetryFailedStages(rooms);
+		}
+		else
+		{
+			// If there are still rooms in the dungeon, switch to triangulation state
+			m_CurrentGenerationState = GenerationCycleState::TRIANGULATION;
+
+			// The super triangle has to contain the center of every room that will be added
+			Vector2 minCenter{ rooms[0].GetPosition() + rooms[0].GetSize() / 2 };
+			Vector2 maxCenter{ minCenter };
+			for (const DungeonRoom& room : rooms)
 			{
-				// If there are still rooms in the dungeon, switch to triangulation state
-				m_CurrentGenerationState = GenerationCycleState::TRIANGULATION;
-				m_Triangulation.StartTriangulation();
+				const Vector2 center{ room.GetPosition() + room.GetSize() / 2 };
+				minCenter.x = min(minCenter.x, center.x);
+				minCenter.y = min(minCenter.y, center.y);
+				maxCenter.x = max(maxCenter.x, center.x);
+				maxCenter.y = max(maxCenter.y, center.y);
 			}
+			m_Triangulation.StartTriangulation(minCenter, maxCenter);
 		}
 		break;
 	}
@@ -187,10 +278,10 @@ void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms)
 			m_Triangulation.FinishTriangulation();
 
 			// If no triangle is created
-			if (m_Triangulation.GetSize() < 3)
+			if (m_Triangulation.GetNrTriangles() == 0)
 			{
-				// Generate a new dungeon
-				GenerateDungeon(rooms);
+				// Retry the failed stages, if there are no retries left the dungeon stays empty
+				RetryFailedStages(rooms);
 			}
 			else
 			{
@@ -205,32 +296,43 @@ void DungeonGenerator::Update(std::vector<DungeonRoom>& rooms)
 		// Create the minimum spanning tree from the triangulated dungeon
 		CreateMinimumSpanningTree();
 
-		// Switch to the corridor creation state
-		m_CurrentGenerationState = GenerationCycleState::CORRIDORS;
+		// If the tree doesn't connect every room
+		if (m_MinimumSpanningTree.size() + 1 < rooms.size())
+		{
+			// Retry the failed stages, if there are no retries left the dungeon stays empty
+			RetryFailedStages(rooms);
+		}
+		else
+		{
+			// Switch to the corridor creation state
+			m_CurrentGenerationState = GenerationCycleState::CORRIDORS;
+		}
 		break;
 	}
 	case GenerationCycleState::CORRIDORS:
 	{
 		// Create corridors between the dungeon rooms
-		CreateCorridors(rooms);
+		CreateCorridors(rooms, connections);
 
 		// Choose the start and the end of the dungeon
-		ChooseBeginAndEndRoom(rooms);
+		ChooseBeginAndEndRoom(rooms, connections);
 
 		// Switch to the finished state
 		m_CurrentGenerationState = GenerationCycleState::DONE;
+		Notify(GenerationEvent{ GenerationEventType::GenerationFinished });
 		break;
 	}
 	}
+
+	// Add the time of this step to its stage
+	if (stage != GenerationCycleState::DONE) AddStageTime(stage, stageStart);
 }
 
+#ifndef DUNGEON_HEADLESS
 void DungeonGenerator::DrawDebug() const
 {
 	// Render the deleted rooms
-	for (const DungeonRoom& room : m_DebugRooms)
-	{
-		room.Draw(true);
-	}
+	DungeonRoom::DrawRooms(m_DebugRooms, true);
 
 	switch (m_CurrentGenerationState)
 	{
@@ -252,17 +354,49 @@ void DungeonGenerator::DrawDebug() const
 	case DungeonGenerator::GenerationCycleState::CORRIDORS:
 	{
 		// Render each edge of the minimum spanning tree
-		GAME_ENGINE->SetColor(RGB(0, 0, 255));
+		std::vector<POINT> lines{};
+		lines.reserve(m_MinimumSpanningTree.size() * 2);
 		for (const Edge& edge : m_MinimumSpanningTree)
 		{
+			// Skip edges that are off screen or that fall within one pixel
 			const Vector2& scaledP0{ CAMERA->ScalePoint(edge.p0.first) };
 			const Vector2& scaledP1{ CAMERA->ScalePoint(edge.p1.first) };
-			GAME_ENGINE->DrawLine(scaledP0.x, scaledP0.y, scaledP1.x, scaledP1.y);
+			if (scaledP0 == scaledP1 || !CAMERA->IsLineOnScreen(scaledP0, scaledP1)) continue;
+
+			lines.push_back(POINT{ scaledP0.x, scaledP0.y });
+			lines.push_back(POINT{ scaledP1.x, scaledP1.y });
 		}
+
+		GAME_ENGINE->SetColor(RGB(0, 0, 255));
+		GAME_ENGINE->DrawLines(lines.data(), static_cast<int>(lines.size() / 2));
 		break;
 	}
 	}
 }
+#endif
+
+const char* DungeonGenerator::GetStageName(GenerationCycleState state)
+{
+	switch (state)
+	{
+	case GenerationCycleState::CIRCLE:
+		return "CIRCLE";
+	case GenerationCycleState::SEPERATION:
+		return "SEPERATION";
+	case GenerationCycleState::DISCARD_SMALL_ROOMS:
+		return "DISCARD_SMALL_ROOMS";
+	case GenerationCycleState::DISCARD_BORDERING_ROOMS:
+		return "DISCARD_BORDERING_ROOMS";
+	case GenerationCycleState::TRIANGULATION:
+		return "TRIANGULATION";
+	case GenerationCycleState::SPANNING_TREE_ALGORITHM:
+		return "SPANNING_TREE_ALGORITHM";
+	case GenerationCycleState::CORRIDORS:
+		return "CORRIDORS";
+	default:
+		return "DONE";
+	}
+}
 
 bool DungeonGenerator::IsDone() const
 {
@@ -279,53 +413,247 @@ int DungeonGenerator::GetInitialRadius() const
 	return m_InitRadius;
 }
 
+void DungeonGenerator::SetInitialRadius(int initRadius)
+{
+	m_InitRadius = min(initRadius, GetMaxInitialRadius());
+}
+
 void DungeonGenerator::SetRoomSizeBounds(int minSize, int maxSize)
 {
 	m_RoomSizeBounds.x = minSize;
 	m_RoomSizeBounds.y = maxSize;
 }
 
-void DungeonGenerator::CreateRoomsInCircle(std::vector<DungeonRoom>& rooms) const
+DungeonGenerator::LayoutSettings DungeonGenerator::GetLayoutSettings() const
+{
+	// The broadphase, the instruction set and slow generation give the exact same layout, so they aren't part of the settings
+	LayoutSettings settings{};
+	settings.seed = m_CurrentSeed;
+	settings.center = m_Center;
+	settings.initRadius = m_InitRadius;
+	settings.initRoomCount = m_InitRoomCount;
+	settings.roomSizeBounds = m_RoomSizeBounds;
+	settings.roomSizeThreshold = m_RoomSizeThreshold;
+	settings.seperationMode = m_SeperationMode;
+	settings.isUsingLongestPath = m_IsUsingLongestPath;
+	return settings;
+}
+
+bool DungeonGenerator::LayoutSettings::operator==(const LayoutSettings& other) const
+{
+	return seed == other.seed && center == other.center && initRadius == other.initRadius && initRoomCount == other.initRoomCount &&
+		roomSizeBounds == other.roomSizeBounds && roomSizeThreshold == other.roomSizeThreshold &&
+		seperationMode == other.seperationMode && isUsingLongestPath == other.isUsingLongestPath;
+}
+
+void DungeonGenerator::SetListener(GenerationListener* pListener)
+{
+	// The triangulation reports its own triangles
+	m_pListener = pListener;
+	m_Triangulation.SetListener(pListener);
+}
+
+bool DungeonGenerator::RetryFailedStages(std::vector<DungeonRoom>& rooms)
+{
+	// The color that the rooms should be drawn in
+	constexpr Color roomColor{ 255, 0 ,0 };
+
+	// The amount of retries before the generator gives up on this seed
+	constexpr int maxRetries{ 10 };
+
+	// If there are no retries left, finish with an empty dungeon
+	if (m_Statistics.nrRetries >= maxRetries)
+	{
+		m_RoomStore.Clear();
+		rooms.clear();
+		m_MinimumSpanningTree.clear();
+		m_CurrentGenerationState = GenerationCycleState::DONE;
+		Notify(GenerationEvent{ GenerationEventType::RoomsCleared });
+		Notify(GenerationEvent{ GenerationEventType::GenerationFinished });
+		return false;
+	}
+
+	// Keep the measurements, the time spent on the failed attempts is part of the generation
+	++m_Statistics.nrRetries;
+
+	// Start again from the seperated rooms, the discarded rooms, the triangulation and the spanning tree are thrown away
+	m_RoomStore = m_SeperatedRoomStore;
+	m_DebugRooms.clear();
+	m_Triangulation.Clear();
+	m_MinimumSpanningTree.clear();
+	m_CurTriangulateRoom = 0;
+
+	// Report the rooms the retry starts from
+	if (m_pListener)
+	{
+		Notify(GenerationEvent{ GenerationEventType::RoomsCleared });
+		for (int i{}; i < m_RoomStore.GetCount(); ++i)
+		{
+			NotifyRoom(GenerationEventType::RoomCreated, i);
+		}
+	}
+
+	if (m_CurRoomSizeThreshold > m_RoomSizeBounds.x)
+	{
+		// Keep more rooms by lowering the size threshold halfway to the smallest room size
+		m_CurRoomSizeThreshold = (m_CurRoomSizeThreshold + m_RoomSizeBounds.x) / 2;
+		m_CurrentGenerationState = GenerationCycleState::DISCARD_SMALL_ROOMS;
+	}
+	else
+	{
+		// Every room is kept already, so add more rooms with a seed derived from the seed of the dungeon
+		m_Random.SetSeed(RandomGenerator::DeriveSeed(m_GenerationSeed, static_cast<uint64_t>(m_Statistics.nrRetries)));
+
+		const int nrNewRooms{ max(m_InitRoomCount / 4, 1) };
+		for (int i{}; i < nrNewRooms; ++i)
+		{
+			CreateRoomInCircle();
+		}
+
+		// The new rooms have to be seperated from the other rooms
+		m_CurrentGenerationState = GenerationCycleState::SEPERATION;
+		m_CurSeperationPass = 0;
+	}
+
+	// Show the rooms the retry starts from
+	m_RoomStore.CreateRooms(rooms, roomColor);
+
+	return true;
+}
+
+bool DungeonGenerator::StopIfCancelled(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
+{
+	if (!m_IsCancelled) return false;
+
+	// Leave an empty dungeon behind, a cancelled dungeon is never used
+	m_RoomStore.Clear();
+	m_SeperatedRoomStore.Clear();
+	rooms.clear();
+	connections.Clear();
+	m_CurrentGenerationState = GenerationCycleState::DONE;
+	Notify(GenerationEvent{ GenerationEventType::RoomsCleared });
+	Notify(GenerationEvent{ GenerationEventType::GenerationFinished });
+
+	return true;
+}
+
+void DungeonGenerator::AddStageTime(GenerationCycleState state, std::chrono::steady_clock::time_point& stageStart)
+{
+	const std::chrono::steady_clock::time_point stageEnd{ std::chrono::steady_clock::now() };
+	m_Statistics.stageSeconds[static_cast<int>(state)] += std::chrono::duration<double>(stageEnd - stageStart).count();
+
+	// The next stage starts now
+	stageStart = stageEnd;
+}
+
+void DungeonGenerator::CreateRoomsInCircle()
 {	
 	// For every room
 	for (int i{}; i < m_InitRoomCount; ++i)
 	{
-		CreateRoomInCircle(rooms);
+		CreateRoomInCircle();
 	}
 }
 
-void DungeonGenerator::CreateRoomInCircle(std::vector<DungeonRoom>& rooms) const
+void DungeonGenerator::CreateRoomInCircle()
 {
-	constexpr float pi{ static_cast<float>(M_PI) };
-
-	// Calculate a random offset from the center
-	const float r = m_InitRadius * sqrtf(RandomFloat(0.0f, 1.0f));
-
-	// Calculate a random angle
-	const float theta = RandomFloat(0.0f, 1.0f) * 2 * pi;
+	// Pick random offsets in the square around the circle until one is inside the circle
+	// Only integer math is used, cosf and sinf round differently on every platform and would move the rooms
+	const long long radius{ m_InitRadius };
+	long long offsetX{};
+	long long offsetY{};
+	do
+	{
+		offsetX = m_Random.RandomLongLong(-radius, radius);
+		offsetY = m_Random.RandomLongLong(-radius, radius);
+	} while (offsetX * offsetX + offsetY * offsetY > radius * radius);
 
 	// Calculate the position
-	const Vector2 pos
-	{
-		static_cast<int>(r * cosf(theta)),
-		static_cast<int>(r * sinf(theta))
-	};
+	const Vector2 pos{ static_cast<int>(offsetX), static_cast<int>(offsetY) };
 
 	// Calculate a random size
 	const Vector2 size
 	{
-		RandomInt(m_RoomSizeBounds.x, m_RoomSizeBounds.y),
-		RandomInt(m_RoomSizeBounds.x, m_RoomSizeBounds.y)
+		m_Random.RandomInt(m_RoomSizeBounds.x, m_RoomSizeBounds.y),
+		m_Random.RandomInt(m_RoomSizeBounds.x, m_RoomSizeBounds.y)
 	};
 
-	// The color that the room should be drawn in
-	constexpr Color roomColor{ 255, 0 ,0 };
+	// Add the room to the store
+	m_RoomStore.Add(m_Center + pos, size);
+	NotifyRoom(GenerationEventType::RoomCreated, m_RoomStore.GetCount() - 1);
+}
+
+bool DungeonGenerator::SeperateRooms()
+{
+	// The amount of passes before the seperation gives up, rooms that still overlap are discarded as bordering rooms
+	constexpr int maxSeperationPasses{ 5000 };
+	if (m_CurSeperationPass >= maxSeperationPasses) return true;
+	++m_CurSeperationPass;
+
+	++m_Statistics.nrSeperationIterations;
+
+	// Remember where every room was, so only the rooms that moved are reported
+	if (m_pListener)
+	{
+		m_PrevRoomPositions.resize(m_RoomStore.GetCount());
+		for (int i{}; i < m_RoomStore.GetCount(); ++i)
+		{
+			m_PrevRoomPositions[i] = m_RoomStore.GetPosition(i);
+		}
+	}
+
+	bool isEveryRoomSeperated{};
+	if (m_SeperationMode == SeperationMode::MinimumTranslation)
+	{
+		// Spread out the rooms before the first pass, the rooms don't have to be pushed through the whole cluster one by one
+		if (m_CurSeperationPass == 1) SpreadRooms();
+
+		isEveryRoomSeperated = SeperateRoomsMinimumTranslation();
+	}
+	else if (m_IsUsingBroadphase)
+	{
+		// Only test nearby rooms if the broadphase is enabled, both paths give the exact same result
+		isEveryRoomSeperated = SeperateRoomsBroadphase();
+	}
+	else
+	{
+		isEveryRoomSeperated = SeperateRoomsBruteForce();
+	}
+
+	if (m_pListener) NotifyRoomsMoved();
+
+	return isEveryRoomSeperated;
+}
+
+bool DungeonGenerator::SeperateRoomsBruteForce()
+{
+	// The maximum speed a room can have compared to another room
+	constexpr int maxSpeed{ 3 };
+
+	// Wether all rooms are not overlapping anymore
+	bool isEveryRoomSeperated{ true };
+
+	// For each room
+	for (int i{}; i < m_RoomStore.GetCount(); ++i)
+	{
+		// The total direction to move in
+		Vector2 seperationDirection{};
 
-	// Create a room and add it to the container
-	rooms.push_back(DungeonRoom{ m_Center + pos, size, roomColor });
+		// Test the room against every other room, if any room overlaps false gets returned, which will repeat the seperation
+		if (RoomKernel::AddSeperationDirection(m_InstructionSet, m_RoomStore, i, maxSpeed, seperationDirection))
+		{
+			isEveryRoomSeperated = false;
+		}
+
+		// Move the room to the calculated seperation direction
+		m_RoomStore.Move(i, seperationDirection);
+	}
+
+	// Return wether all rooms are not overlapping anymore or not
+	return isEveryRoomSeperated;
 }
 
-bool DungeonGenerator::SeperateRooms(std::vector<DungeonRoom>& rooms) const
+bool DungeonGenerator::SeperateRoomsBroadphase()
 {
 	// The maximum speed a room can have compared to another room
 	constexpr int maxSpeed{ 3 };
@@ -333,27 +661,47 @@ bool DungeonGenerator::SeperateRooms(std::vector<DungeonRoom>& rooms) const
 	// Wether all rooms are not overlapping anymore
 	bool isEveryRoomSeperated{ true };
 
+	const int nrRooms{ m_RoomStore.GetCount() };
+
+	// Rebuild the grid, with cells as big as the biggest room every room covers at most 2x2 cells
+	m_RoomGrid.SetCellSize(m_RoomSizeBounds.y);
+	m_RoomGrid.Clear();
+	for (int i{}; i < nrRooms; ++i)
+	{
+		m_RoomGrid.Insert(i, m_RoomStore.GetPosition(i), m_RoomStore.GetSize(i));
+	}
+
 	// For each room
-	for (DungeonRoom& room : rooms)
+	for (int i{}; i < nrRooms; ++i)
 	{
 		// The total direction to move in
 		Vector2 seperationDirection{};
 
-		// For every other room
-		for (DungeonRoom& otherRoom : rooms)
+		const Vector2 position{ m_RoomStore.GetPosition(i) };
+		const Vector2 size{ m_RoomStore.GetSize(i) };
+		const Vector2 center{ m_RoomStore.GetCenter(i) };
+
+		// Only the rooms in the same cells can overlap with this room
+		m_RoomGrid.Query(position, size, m_NearbyRooms);
+
+		// For every nearby room
+		for (int otherIdx : m_NearbyRooms)
 		{
 			// If the other room is the same as the current room, continue to the next room
-			if (&room == &otherRoom) continue;
+			if (otherIdx == i) continue;
+
 			// If the rooms are not overlapping, continue to the next room
-			if (!room.IsOverlapping(otherRoom)) continue;
+			if (!m_RoomStore.IsOverlapping(i, otherIdx)) continue;
 
 			// Makes sure false gets returned, which will repeat the seperation
 			isEveryRoomSeperated = false;
 
 			// Calculate the direction between the rooms
-			Vector2 curDirection{ room.GetPosition() + room.GetSize() / 2 - (otherRoom.GetPosition() + otherRoom.GetSize() / 2) };
+			Vector2 curDirection{ center - m_RoomStore.GetCenter(otherIdx) };
 			// Normalize the direction
 			curDirection.ToDirection();
+			// Rooms with the same center have no direction between them, they are pushed apart horizontally with the lowest index to the left
+			if (curDirection.x == 0 && curDirection.y == 0) curDirection.x = i < otherIdx ? -1 : 1;
 
 			// Set the direction to max speed
 			curDirection *= maxSpeed;
@@ -363,318 +711,669 @@ bool DungeonGenerator::SeperateRooms(std::vector<DungeonRoom>& rooms) const
 		}
 
 		// Move the room to the calculated seperation direction
-		room.Move(seperationDirection);
+		// The grid is updated immediately, the next rooms have to see this room at its new position like in the brute force algorithm
+		m_RoomStore.Move(i, seperationDirection);
+		m_RoomGrid.Move(i, position, m_RoomStore.GetPosition(i), size);
 	}
 
 	// Return wether all rooms are not overlapping anymore or not
 	return isEveryRoomSeperated;
 }
 
-bool DungeonGenerator::DiscardSmallRooms(std::vector<DungeonRoom>& rooms, bool debug)
+bool DungeonGenerator::SeperateRoomsMinimumTranslation()
 {
-	// Loop over all the rooms
-	for(int i{ static_cast<int>(rooms.size()) - 1 }; i >= 0; --i)
+	// Every push is over-relaxed by this fraction, the other room also moves away so a room only takes half of the overlap
+	constexpr int relaxationNumerator{ 3 };
+	constexpr int relaxationDenominator{ 2 };
+
+	// Wether all rooms are not overlapping anymore
+	bool isEveryRoomSeperated{ true };
+
+	const int nrRooms{ m_RoomStore.GetCount() };
+
+	// A room never moves further than the biggest room size in one pass, this keeps dense clusters from exploding
+	const int maxStep{ m_RoomSizeBounds.y };
+
+	// Rebuild the grid, with cells as big as the biggest room every room covers at most 2x2 cells
+	if (m_IsUsingBroadphase)
 	{
-		// Get the current room
-		const DungeonRoom& room{ rooms[i] };
+		m_RoomGrid.SetCellSize(m_RoomSizeBounds.y);
+		m_RoomGrid.Clear();
+		for (int i{}; i < nrRooms; ++i)
+		{
+			m_RoomGrid.Insert(i, m_RoomStore.GetPosition(i), m_RoomStore.GetSize(i));
+		}
+	}
 
-		// If one of the size parameters is smaller then the threshold
-		if (room.GetSize().x < m_RoomSizeThreshold || room.GetSize().y < m_RoomSizeThreshold)
+	// For each room
+	for (int i{}; i < nrRooms; ++i)
+	{
+		// The total direction to move in
+		Vector2 seperationDirection{};
+
+		const Vector2 position{ m_RoomStore.GetPosition(i) };
+		const Vector2 size{ m_RoomStore.GetSize(i) };
+
+		// Test the nearby rooms if the broadphase is enabled, every room otherwise
+		if (m_IsUsingBroadphase)
 		{
-			// Add the room to the debug room list, this will make sure the rooms are still drawn, but in a different color
-			m_DebugRooms.push_back(room);
+			m_RoomGrid.Query(position, size, m_NearbyRooms);
+		}
+		else
+		{
+			m_NearbyRooms.resize(nrRooms);
+			for (int otherIdx{}; otherIdx < nrRooms; ++otherIdx)
+			{
+				m_NearbyRooms[otherIdx] = otherIdx;
+			}
+		}
+
+		// For every nearby room
+		for (int otherIdx : m_NearbyRooms)
+		{
+			// If the other room is the same as the current room, continue to the next room
+			if (otherIdx == i) continue;
+
+			// If the rooms are not overlapping, continue to the next room
+			if (!m_RoomStore.IsOverlapping(i, otherIdx)) continue;
+
+			// Makes sure false gets returned, which will repeat the seperation
+			isEveryRoomSeperated = false;
+
+			const Vector2 otherPosition{ m_RoomStore.GetPosition(otherIdx) };
+			const Vector2 otherSize{ m_RoomStore.GetSize(otherIdx) };
+
+			// Calculate how far the rooms overlap on each axis
+			const int overlapX{ min(position.x + size.x, otherPosition.x + otherSize.x) - max(position.x, otherPosition.x) };
+			const int overlapY{ min(position.y + size.y, otherPosition.y + otherSize.y) - max(position.y, otherPosition.y) };
+
+			// The room is pushed out along the axis with the smallest overlap, away from the center of the other room
+			// Twice the center is used to stay in integers, rooms with the same center are pushed apart by their index
+			const bool isPushedHorizontally{ overlapX <= overlapY };
+			const int centerOffset{ isPushedHorizontally ?
+				(position.x * 2 + size.x) - (otherPosition.x * 2 + otherSize.x) :
+				(position.y * 2 + size.y) - (otherPosition.y * 2 + otherSize.y) };
+			const int pushSign{ centerOffset != 0 ? (centerOffset > 0 ? 1 : -1) : (i < otherIdx ? -1 : 1) };
 
-			// Remove the current room from the list of rooms
-			rooms[i] = rooms[rooms.size() - 1];
-			rooms.pop_back();
+			// Push the room half of the over-relaxed overlap, rounded up so every push moves the room
+			const int overlap{ isPushedHorizontally ? overlapX : overlapY };
+			const int push{ (overlap * relaxationNumerator + 2 * relaxationDenominator - 1) / (2 * relaxationDenominator) };
 
-			if (debug)
+			if (isPushedHorizontally)
 			{
-				// Return false so the while loop continues
-				return false;
+				seperationDirection.x += pushSign * push;
+			}
+			else
+			{
+				seperationDirection.y += pushSign * push;
 			}
 		}
+
+		// Limit the step of this pass
+		seperationDirection.x = max(-maxStep, min(seperationDirection.x, maxStep));
+		seperationDirection.y = max(-maxStep, min(seperationDirection.y, maxStep));
+
+		// Move the room to the calculated seperation direction, the next rooms see this room at its new position
+		m_RoomStore.Move(i, seperationDirection);
+		if (m_IsUsingBroadphase) m_RoomGrid.Move(i, position, m_RoomStore.GetPosition(i), size);
 	}
 
-	// Return true so the while loop stops
-	return true;
+	// Return wether all rooms are not overlapping anymore or not
+	return isEveryRoomSeperated;
 }
 
-bool DungeonGenerator::DiscardBorderingRooms(std::vector<DungeonRoom>& rooms, bool debug)
+void DungeonGenerator::SpreadRooms()
 {
-	// The minimal amount of space between two rooms
-	constexpr int minCorridorSize{ 10 };
+	// The part of the circle that should be covered by rooms after spreading, rooms rarely fit tighter than this
+	constexpr float targetCoverage{ 0.5f };
+	constexpr float pi{ static_cast<float>(M_PI) };
 
-	// Loop over all the rooms
-	for (int i{ static_cast<int>(rooms.size()) - 1 }; i >= 0; --i)
+	const int nrRooms{ m_RoomStore.GetCount() };
+
+	// Calculate the total area of all rooms and the distance of the furthest room from the center
+	float totalArea{};
+	float maxDistanceSqr{};
+	for (int i{}; i < nrRooms; ++i)
 	{
-		// Get the current room
-		const DungeonRoom& room{ rooms[i] };
+		const Vector2 size{ m_RoomStore.GetSize(i) };
+		totalArea += static_cast<float>(size.x) * static_cast<float>(size.y);
+
+		const Vector2 offset{ m_RoomStore.GetPosition(i) - m_Center };
+		maxDistanceSqr = max(maxDistanceSqr, static_cast<float>(offset.x) * offset.x + static_cast<float>(offset.y) * offset.y);
+	}
 
-		// Loop over all the rooms
-		for (int j{ static_cast<int>(rooms.size()) - 1 }; j >= 0; --j)
+	// The radius of the circle that has the target coverage
+	const float targetRadius{ sqrtf(totalArea / (targetCoverage * pi)) };
+	const float maxDistance{ sqrtf(maxDistanceSqr) };
+
+	// If the rooms are already spread out far enough, don't move them
+	if (maxDistance <= 0.0f || targetRadius <= maxDistance) return;
+
+	// Move every room away from the center, rooms keep their position relative to each other
+	const float scale{ targetRadius / maxDistance };
+	for (int i{}; i < nrRooms; ++i)
+	{
+		const Vector2 offset{ m_RoomStore.GetPosition(i) - m_Center };
+		const Vector2 scaledOffset
 		{
-			if (i == j) continue;
+			static_cast<int>(offset.x * scale),
+			static_cast<int>(offset.y * scale)
+		};
+		m_RoomStore.Move(i, scaledOffset - offset);
+	}
+}
+
+void DungeonGenerator::DiscardSmallRooms()
+{
+	// The color that the room should be drawn in
+	constexpr Color roomColor{ 255, 0 ,0 };
 
-			// Get the current room
-			const DungeonRoom& other{ rooms[j] };
+	// Mark every room of which one of the size parameters is smaller then the threshold
+	const int nrRooms{ m_RoomStore.GetCount() };
+	m_IsRoomDiscarded.assign(nrRooms, false);
+	for (int i{}; i < nrRooms; ++i)
+	{
+		const Vector2 size{ m_RoomStore.GetSize(i) };
+		if (size.x >= m_CurRoomSizeThreshold && size.y >= m_CurRoomSizeThreshold) continue;
 
-			// Distance between the rooms
-			const Vector2 distance{ room.GetPosition() + room.GetSize() / 2 - (other.GetPosition() + other.GetSize() / 2) };
-			const int roomDistX{ abs(distance.x) };
-			const int roomDistY{ abs(distance.y) };
+		m_IsRoomDiscarded[i] = true;
+		NotifyRoom(GenerationEventType::RoomDiscarded, i);
 
-			// The amount of space needed between buildings to have the minimal corridor
-			const int minCorridorSizeSpaceX{ room.GetSize().x / 2 + other.GetSize().x / 2 + minCorridorSize };
-			const int minCorridorSizeSpaceY{ room.GetSize().y / 2 + other.GetSize().y / 2 + minCorridorSize };
+		// Add the room to the debug room list, this will make sure the rooms are still drawn, but in a different color
+		m_DebugRooms.push_back(m_RoomStore.CreateRoom(i, roomColor));
+	}
 
-			// Get which kind of corridor will be created
-			const bool isCorridorFlat{ roomDistX > roomDistY };
+	// Remove every marked room at once
+	m_RoomStore.RemoveRooms(m_IsRoomDiscarded);
+	Notify(GenerationEvent{ GenerationEventType::RoomsRemoved });
+}
 
-			// If the rooms are too close to each other depending on which corridor will be created
-			if (isCorridorFlat && roomDistX < minCorridorSizeSpaceX || !isCorridorFlat && roomDistY < minCorridorSizeSpaceY)
-			{
-				// Add the room to the debug room list, this will make sure the rooms are still drawn, but in a different color
-				m_DebugRooms.push_back(room);
+void DungeonGenerator::DiscardBorderingRooms()
+{
+	// The minimal amount of space between two rooms
+	constexpr int minCorridorSize{ 10 };
 
-				// Remove the current room from the list of rooms
-				rooms[i] = rooms[rooms.size() - 1];
-				rooms.pop_back();
+	// A discarded room is moved this far away, so the room kernel never finds it bordering another room
+	constexpr int discardedRoomOffset{ 1 << 28 };
 
-				if (debug)
-				{
-					// Return false so the while loop continues
-					return false;
-				}
-				break;
-			}
-		}
+	// The color that the room should be drawn in
+	constexpr Color roomColor{ 255, 0 ,0 };
+
+	const int nrRooms{ m_RoomStore.GetCount() };
+	m_IsRoomDiscarded.assign(nrRooms, false);
+
+	// Test the rooms from the last to the first, a discarded room is not tested against anymore so only one of two bordering rooms is discarded
+	for (int i{ nrRooms - 1 }; i >= 0; --i)
+	{
+		// If the room is too close to any other room to fit a corridor, discard the room
+		if (!RoomKernel::IsBordering(m_InstructionSet, m_RoomStore, i, minCorridorSize)) continue;
+
+		m_IsRoomDiscarded[i] = true;
+		NotifyRoom(GenerationEventType::RoomDiscarded, i);
+
+		// Add the room to the debug room list, this will make sure the rooms are still drawn, but in a different color
+		m_DebugRooms.push_back(m_RoomStore.CreateRoom(i, roomColor));
+
+		// Move the room out of the way of the rooms that are tested next
+		m_RoomStore.Move(i, Vector2{ -discardedRoomOffset, -discardedRoomOffset });
 	}
 
-	// Return false so the while loop stops
-	return true;
+	// Remove every marked room at once
+	m_RoomStore.RemoveRooms(m_IsRoomDiscarded);
+	Notify(GenerationEvent{ GenerationEventType::RoomsRemoved });
 }
 
 void DungeonGenerator::CreateMinimumSpanningTree()
 {
-	// Collection of trees
-	std::vector<Tree> forest{};
-	
 	// All the edges of the triangulation, sorted by length
-	std::set<Edge> edges{};
-	m_Triangulation.CreateSetOfEdges(edges);
+	m_Triangulation.CreateListOfEdges(m_TriangulationEdges);
 
 	// The amount of vertices/rooms
 	const size_t nrVertices{ m_Triangulation.GetSize() };
 
-	// As long as there are edges to check and the amount of edges in the MST is less then the amount of vertices - 1
-	while (!edges.empty() && (forest.empty() || forest[0].edges.size() < nrVertices - 1))
-	{
-		// Get the shortest edge and remove it from the set
-		Edge curEdge{ *edges.begin() };
-		edges.erase(curEdge);
-
-		bool createsLoop{};
-		
-		// The index of the tree it connects with
-		int connectedTreeIdx{ -1 };
+	// Every vertex starts in its own set, a vertex only becomes part of a tree once an edge connects it
+	m_Vertices.Reset(nrVertices);
+	m_VertexTrees.assign(nrVertices, -1);
 
-		// For each tree
-		for (size_t i{}; i < forest.size(); ++i)
-		{
-			// Get a reference to the current tree
-			const Tree& tree{ forest[i] };
+	// The trees in the forest, their edges are stored as linked lists so merging trees doesn't copy any edges
+	m_Trees.clear();
+	m_Forest.clear();
+	m_NextTreeEdges.assign(m_TriangulationEdges.size(), -1);
 
-			// Check whether the current edge connected with the tree
-			const TreeConnectionState connection{ tree.IsConnected(curEdge) };
+	// The amount of edges that have been accepted over all trees
+	size_t nrTreeEdges{};
 
-			// If the edge makes the tree loop, continue to the next edge
-			if (connection == TreeConnectionState::Loop)
-			{
-				createsLoop = true;
-				break;
-			}
-
-			// If the edge is not connected to this tree, continue to the next tree
-			if (connection != TreeConnectionState::Connected) continue;
+	// As long as there are edges to check and the amount of edges in the MST is less then the amount of vertices - 1
+	for (int edgeIdx{}; edgeIdx < static_cast<int>(m_TriangulationEdges.size()) && nrTreeEdges + 1 < nrVertices; ++edgeIdx)
+	{
+		// Get the current edge
+		const Edge& curEdge{ m_TriangulationEdges[edgeIdx] };
+		const int vertex0{ curEdge.p0.second };
+		const int vertex1{ curEdge.p1.second };
 
-			if (connectedTreeIdx == -1)
-			{
-				// If the edge is not connected to any tree yet, save the index of the current tree
-				connectedTreeIdx = static_cast<int>(i);
-			}
-			else
-			{
-				// If the edge is already connected to a tree, merge the two trees and remove the current tree
-				forest[connectedTreeIdx].Merge(tree);
-				forest[i] = forest[forest.size() - 1];
-				forest.pop_back();
-				break;
-			}
-		}
+		// Get the trees the edge is connected with
+		const int tree0{ m_VertexTrees[vertex0] < 0 ? -1 : m_VertexTrees[m_Vertices.Find(vertex0)] };
+		const int tree1{ m_VertexTrees[vertex1] < 0 ? -1 : m_VertexTrees[m_Vertices.Find(vertex1)] };
 
 		// If the edge makes the tree loop, continue to the next edge
-		if (createsLoop) continue;
+		if (tree0 >= 0 && tree0 == tree1) continue;
 
-		if (connectedTreeIdx == -1)
+		// The index of the tree this edge is added to
+		int connectedTreeIdx{};
+
+		if (tree0 < 0 && tree1 < 0)
 		{
 			// If the edge is not connected to any tree, create a new tree
-			forest.push_back(Tree{ { curEdge }, { curEdge.p0.second, curEdge.p1.second } });
+			connectedTreeIdx = static_cast<int>(m_Trees.size());
+			m_Trees.push_back(ForestTree{ -1, -1, static_cast<int>(m_Forest.size()) });
+			m_Forest.push_back(connectedTreeIdx);
+		}
+		else if (tree0 < 0 || tree1 < 0)
+		{
+			// If the edge is connected with only one tree, add the edge to this tree
+			connectedTreeIdx = tree0 < 0 ? tree1 : tree0;
 		}
 		else
 		{
-			// If the edge is connected to a tree, add the edge to the edges of the tree
-			forest[connectedTreeIdx].edges.push_back(curEdge);
-			forest[connectedTreeIdx].vertices.insert(curEdge.p0.second);
-			forest[connectedTreeIdx].vertices.insert(curEdge.p1.second);
+			// If the edge is connected with two trees, merge the tree that comes last in the forest into the first tree
+			ForestTree& firstTree{ m_Trees[tree0] };
+			ForestTree& lastTree{ m_Trees[tree1] };
+			connectedTreeIdx = firstTree.forestIdx < lastTree.forestIdx ? tree0 : tree1;
+			ForestTree& mergedTree{ firstTree.forestIdx < lastTree.forestIdx ? firstTree : lastTree };
+			ForestTree& removedTree{ firstTree.forestIdx < lastTree.forestIdx ? lastTree : firstTree };
+
+			// Append the edges of the removed tree to the edges of the merged tree
+			m_NextTreeEdges[mergedTree.lastEdge] = removedTree.firstEdge;
+			mergedTree.lastEdge = removedTree.lastEdge;
+
+			// Remove the tree from the forest
+			m_Forest[removedTree.forestIdx] = m_Forest[m_Forest.size() - 1];
+			m_Trees[m_Forest[removedTree.forestIdx]].forestIdx = removedTree.forestIdx;
+			m_Forest.pop_back();
 		}
+
+		// Add the edge to the edges of the tree
+		ForestTree& tree{ m_Trees[connectedTreeIdx] };
+		if (tree.lastEdge < 0)
+		{
+			tree.firstEdge = edgeIdx;
+		}
+		else
+		{
+			m_NextTreeEdges[tree.lastEdge] = edgeIdx;
+		}
+		tree.lastEdge = edgeIdx;
+		++nrTreeEdges;
+
+		// Add the vertices to the tree
+		const int root{ m_Vertices.Union(vertex0, vertex1) };
+		m_VertexTrees[vertex0] = connectedTreeIdx;
+		m_VertexTrees[vertex1] = connectedTreeIdx;
+		m_VertexTrees[root] = connectedTreeIdx;
 	}
 
-	// Move the main tree (the minimum spanning tree) to a member variable
-	m_MinimumSpanningTree = std::move(forest[0].edges);
+	// Copy the main tree (the minimum spanning tree) to a member variable
+	m_MinimumSpanningTree.clear();
+	if (m_Forest.empty()) return;
+
+	for (int edgeIdx{ m_Trees[m_Forest[0]].firstEdge }; edgeIdx >= 0; edgeIdx = m_NextTreeEdges[edgeIdx])
+	{
+		const Edge& edge{ m_TriangulationEdges[edgeIdx] };
+		m_MinimumSpanningTree.push_back(edge);
+		Notify(GenerationEvent{ GenerationEventType::SpanningTreeEdgeAdded, 0, { edge.p0.second, edge.p1.second } });
+	}
 }
 
-void DungeonGenerator::CreateCorridors(std::vector<DungeonRoom>& rooms) const
+void DungeonGenerator::CreateCorridors(std::vector<DungeonRoom>& rooms, AdjacencyList& connections)
 {
-	// The minimum allowed size of the corridor
-	constexpr int minSize{ 20 };
+	const int nrRooms{ static_cast<int>(rooms.size()) };
 
-	// The color of corridors
-	constexpr Color corridorColor{ 255, 127, 127 };
+	// The connections between the rooms and the corridors
+	m_ConnectionLinks.clear();
+
+	// Every edge creates at most 2 corridors with 3 links in both directions
+	rooms.reserve(rooms.size() + m_MinimumSpanningTree.size() * 2);
+	m_ConnectionLinks.reserve(m_MinimumSpanningTree.size() * 6);
+
+	// Put every room in the grid, corridors are only tested against rooms
+	m_RoomGrid.SetCellSize(m_RoomSizeBounds.y);
+	m_RoomGrid.Clear();
+	m_RoomsByX.clear();
+	m_MaxRoomWidth = 0;
+	for (int i{}; i < nrRooms; ++i)
+	{
+		m_RoomGrid.Insert(i, rooms[i].GetPosition(), rooms[i].GetSize());
+
+		m_RoomsByX.push_back(std::make_pair(rooms[i].GetPosition().x, i));
+		m_MaxRoomWidth = max(m_MaxRoomWidth, rooms[i].GetSize().x);
+	}
+	std::sort(m_RoomsByX.begin(), m_RoomsByX.end());
 
 	// For every edge in the MST
 	for (const Edge& edge : m_MinimumSpanningTree)
 	{
 		// Get the two rooms connected to this edge
-		DungeonRoom& room0{ rooms[edge.p0.second] };
-		DungeonRoom& room1{ rooms[edge.p1.second] };
+		const int room0Idx{ edge.p0.second };
+		const int room1Idx{ edge.p1.second };
+		const DungeonRoom& room0{ rooms[room0Idx] };
+		const DungeonRoom& room1{ rooms[room1Idx] };
+
+		// Try a straight corridor first, then both bent corridors, until a corridor is found that doesn't cross another room
+		Corridor straightCorridor{};
+		Corridor bentCorridors[2]{};
+		Corridor fallbackCorridor{};
+		const bool isStraightCorridorValid{ CreateStraightCorridor(room0, room1, straightCorridor) };
+		const bool isBentCorridorValid[2]{ CreateBentCorridor(room0, room1, true, true, bentCorridors[0]), CreateBentCorridor(room0, room1, false, true, bentCorridors[1]) };
+
+		const Corridor* pCorridor{};
+		if (isStraightCorridorValid && IsCorridorFree(rooms, straightCorridor, room0Idx, room1Idx)) pCorridor = &straightCorridor;
+		else if (isBentCorridorValid[0] && IsCorridorFree(rooms, bentCorridors[0], room0Idx, room1Idx)) pCorridor = &bentCorridors[0];
+		else if (isBentCorridorValid[1] && IsCorridorFree(rooms, bentCorridors[1], room0Idx, room1Idx)) pCorridor = &bentCorridors[1];
+		else
+		{
+			// If every corridor crosses another room, keep the rooms connected with a corridor that crosses a room
+			if (isStraightCorridorValid) pCorridor = &straightCorridor;
+			else if (isBentCorridorValid[0]) pCorridor = &bentCorridors[0];
+			else if (isBentCorridorValid[1]) pCorridor = &bentCorridors[1];
+
+			// If no corridor fits, only rooms that touch each other are connected without a corridor
+			// Rooms that don't touch are connected with a bent corridor that isn't cut off by the rooms, it goes into both rooms
+			else if (!room0.IsTouching(room1))
+			{
+				CreateBentCorridor(room0, room1, true, false, fallbackCorridor);
+				pCorridor = &fallbackCorridor;
+			}
 
-		// Get the center of each room
-		const Vector2 room0Pos{ room0.GetPosition() + room0.GetSize() / 2 };
-		const Vector2 room1Pos{ room1.GetPosition() + room1.GetSize() / 2 };
+			// Count the rooms that aren't connected by a corridor that fits between them
+			if (pCorridor) ++m_Statistics.nrBlockedCorridors;
+		}
 
-		// If the x and y directions go from room 0 to 1 or not
-		bool directionX01{};
-		bool directionY01{};
+		Corridor noCorridor{};
+		AddCorridor(rooms, pCorridor ? *pCorridor : noCorridor, room0Idx, room1Idx);
+	}
 
-		// The bottom left corner of the new corridor
-		Vector2 bottomLeft{};
+	// Store the connections of every room next to each other
+	connections.Build(rooms.size(), m_ConnectionLinks);
+}
 
-		// Set the x direction and the x component of the leftbottom corner
-		if (room0Pos.x < room1Pos.x)
+bool DungeonGenerator::CreateStraightCorridor(const DungeonRoom& room0, const DungeonRoom& room1, Corridor& corridor) const
+{
+	// The minimum allowed size of the corridor
+	constexpr int minSize{ 20 };
+
+	// Get the center of each room
+	const Vector2 room0Pos{ room0.GetPosition() + room0.GetSize() / 2 };
+	const Vector2 room1Pos{ room1.GetPosition() + room1.GetSize() / 2 };
+
+	// If the x and y directions go from room 0 to 1 or not
+	bool directionX01{};
+	bool directionY01{};
+
+	// The bottom left corner of the new corridor
+	Vector2 bottomLeft{};
+
+	// Set the x direction and the x component of the leftbottom corner
+	if (room0Pos.x < room1Pos.x)
+	{
+		bottomLeft.x = room0Pos.x;
+		directionX01 = true;
+	}
+	else
+	{
+		bottomLeft.x = room1Pos.x;
+	}
+
+	// Set the y direction and the y component of the leftbottom corner
+	if (room0Pos.y < room1Pos.y)
+	{
+		bottomLeft.y = room0Pos.y;
+		directionY01 = true;
+	}
+	else
+	{
+		bottomLeft.y = room1Pos.y;
+	}
+
+	// The size of the corridor
+	Vector2 size{ abs(room0Pos.x - room1Pos.x), abs(room0Pos.y - room1Pos.y) };
+
+	// If the size of the corridor is smaller then the minimum allowed size, scale and move the corridor
+	if (size.x < minSize)
+	{
+		const int sizeGrow{ minSize - size.x };
+		size.x = minSize;
+		bottomLeft.x -= sizeGrow / 2;
+	}
+	if (size.y < minSize)
+	{
+		const int sizeGrow{ minSize - size.y };
+		size.y = minSize;
+		bottomLeft.y -= sizeGrow / 2;
+	}
+
+	// The displacements at the left, top, right and bottom
+	int leftDisplacement{};
+	int rightDisplacement{};
+	int bottomDisplacement{};
+	int topDisplacement{};
+
+	// Is this room a vertical or horizontal corridor
+	const bool isHorizontalCorridor{ size.x > size.y };
+
+	// Depending on a horizontal or vertical corridor, calculate the displacement amounts
+	if (isHorizontalCorridor)
+	{
+		if (directionX01)
 		{
-			bottomLeft.x = room0Pos.x;
-			directionX01 = true;
+			leftDisplacement = (room0Pos + room0.GetSize() / 2).x - bottomLeft.x;
+			rightDisplacement = bottomLeft.x + size.x - (room1Pos - room1.GetSize() / 2).x;
 		}
 		else
 		{
-			bottomLeft.x = room1Pos.x;
+			leftDisplacement = (room1Pos + room1.GetSize() / 2).x - bottomLeft.x;
+			rightDisplacement = bottomLeft.x + size.x - (room0Pos - room1.GetSize() / 2).x;
 		}
-
-		// Set the y direction and the y component of the leftbottom corner
-		if (room0Pos.y < room1Pos.y)
+	}
+	else
+	{
+		if (directionY01)
 		{
-			bottomLeft.y = room0Pos.y;
-			directionY01 = true;
+			bottomDisplacement = (room0Pos + room0.GetSize() / 2).y - bottomLeft.y;
+			topDisplacement = bottomLeft.y + size.y - (room1Pos - room1.GetSize() / 2).y;
 		}
 		else
 		{
-			bottomLeft.y = room1Pos.y;
+			bottomDisplacement = (room1Pos + room1.GetSize() / 2).y - bottomLeft.y;
+			topDisplacement = bottomLeft.y + size.y - (room0Pos - room0.GetSize() / 2).y;
 		}
+	}
 
-		// The size of the corridor
-		Vector2 size{ abs(room0Pos.x - room1Pos.x), abs(room0Pos.y - room1Pos.y) };
+	// Move and scale the corridor according to the calculated displacements
+	bottomLeft.x += leftDisplacement;
+	size.x -= leftDisplacement;
+	size.x -= rightDisplacement;
+	bottomLeft.y += bottomDisplacement;
+	size.y -= bottomDisplacement;
+	size.y -= topDisplacement;
+
+	// If the size of the corridor has become 0 or less, the corridor can't be used
+	if (size.x <= 0 || size.y <= 0) return false;
+
+	corridor.positions[0] = bottomLeft;
+	corridor.sizes[0] = size;
+	corridor.nrParts = 1;
+	return true;
+}
 
-		// If the size of the corridor is smaller then the minimum allowed size, scale and move the corridor
-		if (size.x < minSize)
+bool DungeonGenerator::CreateBentCorridor(const DungeonRoom& room0, const DungeonRoom& room1, bool isHorizontalFirst, bool isCutByRooms, Corridor& corridor) const
+{
+	// The width of the corridor
+	constexpr int corridorSize{ 20 };
+	constexpr int halfCorridorSize{ corridorSize / 2 };
+
+	// Get the center of each room
+	const Vector2 room0Pos{ room0.GetPosition() + room0.GetSize() / 2 };
+	const Vector2 room1Pos{ room1.GetPosition() + room1.GetSize() / 2 };
+
+	// The corridor goes from the center of room 0 to the corner, and from the corner to the center of room 1
+	const Vector2 corner{ isHorizontalFirst ? Vector2{ room1Pos.x, room0Pos.y } : Vector2{ room0Pos.x, room1Pos.y } };
+
+	// The first part also covers the corner, so the second part starts after the corner
+	Vector2 positions[2]{};
+	Vector2 sizes[2]{};
+	const Vector2 partStarts[2]{ room0Pos, corner };
+	const Vector2 partEnds[2]{ corner, room1Pos };
+	for (int part{}; part < 2; ++part)
+	{
+		const bool isHorizontalPart{ (part == 0) == isHorizontalFirst };
+		const int start{ isHorizontalPart ? partStarts[part].x : partStarts[part].y };
+		const int end{ isHorizontalPart ? partEnds[part].x : partEnds[part].y };
+		const int crossCenter{ isHorizontalPart ? partStarts[part].y : partStarts[part].x };
+
+		// The range of the part along its direction, the first part grows over the corner and the second part shrinks
+		int minAlong{ min(start, end) };
+		int maxAlong{ max(start, end) };
+		if (part == 0)
 		{
-			const int sizeGrow{ minSize - size.x };
-			size.x = minSize;
-			bottomLeft.x -= sizeGrow / 2;
+			if (end >= start) maxAlong += halfCorridorSize;
+			else minAlong -= halfCorridorSize;
 		}
-		if (size.y < minSize)
+		else
 		{
-			const int sizeGrow{ minSize - size.y };
-			size.y = minSize;
-			bottomLeft.y -= sizeGrow / 2;
+			if (end >= start) minAlong += halfCorridorSize;
+			else maxAlong -= halfCorridorSize;
 		}
 
-		// The displacements at the left, top, right and bottom
-		int leftDisplacement{};
-		int rightDisplacement{};
-		int bottomDisplacement{};
-		int topDisplacement{};
-
-		// Is this room a vertical or horizontal corridor
-		const bool isHorizontalCorridor{ size.x > size.y };
-
-		// Depending on a horizontal or vertical corridor, calculate the displacement amounts
-		if (isHorizontalCorridor)
+		// Remove the parts that are inside one of the connected rooms, a corridor that isn't cut by the rooms keeps these parts
+		if (isCutByRooms)
 		{
-			if (directionX01)
+			for (const DungeonRoom* pRoom : { &room0, &room1 })
 			{
-				leftDisplacement = (room0Pos + room0.GetSize() / 2).x - bottomLeft.x;
-				rightDisplacement = bottomLeft.x + size.x - (room1Pos - room1.GetSize() / 2).x;
-			}
-			else
-			{
-				leftDisplacement = (room1Pos + room1.GetSize() / 2).x - bottomLeft.x;
-				rightDisplacement = bottomLeft.x + size.x - (room0Pos - room1.GetSize() / 2).x;
+				const int roomMinAlong{ isHorizontalPart ? pRoom->GetPosition().x : pRoom->GetPosition().y };
+				const int roomMaxAlong{ roomMinAlong + (isHorizontalPart ? pRoom->GetSize().x : pRoom->GetSize().y) };
+				const int roomMinCross{ isHorizontalPart ? pRoom->GetPosition().y : pRoom->GetPosition().x };
+				const int roomMaxCross{ roomMinCross + (isHorizontalPart ? pRoom->GetSize().y : pRoom->GetSize().x) };
+
+				// If the part doesn't touch the room, nothing has to be removed
+				if (roomMaxCross <= crossCenter - halfCorridorSize || roomMinCross >= crossCenter + halfCorridorSize) continue;
+				if (roomMaxAlong <= minAlong || roomMinAlong >= maxAlong) continue;
+
+				// A part that goes through a connected room would connect it twice
+				if (roomMinAlong > minAlong && roomMaxAlong < maxAlong) return false;
+
+				if (roomMinAlong <= minAlong) minAlong = roomMaxAlong;
+				if (roomMaxAlong >= maxAlong) maxAlong = roomMinAlong;
 			}
 		}
-		else
+
+		// The part is completely inside the rooms
+		if (maxAlong <= minAlong)
 		{
-			if (directionY01)
-			{
-				bottomDisplacement = (room0Pos + room0.GetSize() / 2).y - bottomLeft.y;
-				topDisplacement = bottomLeft.y + size.y - (room1Pos - room1.GetSize() / 2).y;
-			}
-			else
+			sizes[part] = Vector2{};
+			continue;
+		}
+
+		positions[part] = isHorizontalPart ? Vector2{ minAlong, crossCenter - halfCorridorSize } : Vector2{ crossCenter - halfCorridorSize, minAlong };
+		sizes[part] = isHorizontalPart ? Vector2{ maxAlong - minAlong, corridorSize } : Vector2{ corridorSize, maxAlong - minAlong };
+	}
+
+	// Store the parts that are not inside the rooms
+	corridor.nrParts = 0;
+	for (int part{}; part < 2; ++part)
+	{
+		if (sizes[part].x <= 0) continue;
+
+		corridor.positions[corridor.nrParts] = positions[part];
+		corridor.sizes[corridor.nrParts] = sizes[part];
+		++corridor.nrParts;
+	}
+
+	return corridor.nrParts > 0;
+}
+
+bool DungeonGenerator::IsCorridorFree(const std::vector<DungeonRoom>& rooms, const Corridor& corridor, int room0Idx, int room1Idx)
+{
+	for (int part{}; part < corridor.nrParts; ++part)
+	{
+		const Vector2& position{ corridor.positions[part] };
+		const Vector2& size{ corridor.sizes[part] };
+		const DungeonRoom corridorRoom{ position, size, Color{} };
+
+		// Only rooms with a left side between these coordinates can overlap the part
+		const auto firstRoomIt{ std::lower_bound(m_RoomsByX.begin(), m_RoomsByX.end(), std::make_pair(position.x - m_MaxRoomWidth + 1, INT_MIN)) };
+		const auto lastRoomIt{ std::lower_bound(firstRoomIt, m_RoomsByX.end(), std::make_pair(position.x + size.x, INT_MIN)) };
+
+		// A part that covers more cells than there are rooms next to it is tested against these rooms, walking its cells would take longer
+		if (lastRoomIt - firstRoomIt < m_RoomGrid.GetNrCells(position, size))
+		{
+			for (auto roomIt{ firstRoomIt }; roomIt != lastRoomIt; ++roomIt)
 			{
-				bottomDisplacement = (room1Pos + room1.GetSize() / 2).y - bottomLeft.y;
-				topDisplacement = bottomLeft.y + size.y - (room0Pos - room0.GetSize() / 2).y;
+				const int roomIdx{ roomIt->second };
+				if (roomIdx == room0Idx || roomIdx == room1Idx) continue;
+
+				if (corridorRoom.IsOverlapping(rooms[roomIdx])) return false;
 			}
+			continue;
+		}
+
+		// Test every room near the corridor, except for the rooms it connects
+		m_RoomGrid.Query(position, size, m_NearbyRooms);
+		for (int roomIdx : m_NearbyRooms)
+		{
+			if (roomIdx == room0Idx || roomIdx == room1Idx) continue;
+
+			if (corridorRoom.IsOverlapping(rooms[roomIdx])) return false;
 		}
+	}
 
-		// Move and scale the corridor according to the calculated displacements
-		bottomLeft.x += leftDisplacement;
-		size.x -= leftDisplacement;
-		size.x -= rightDisplacement;
-		bottomLeft.y += bottomDisplacement;
-		size.y -= bottomDisplacement;
-		size.y -= topDisplacement;
+	return true;
+}
 
-		// If the size of the corridor has become 0 or less, continue to the next corridor
-		if (size.x <= 0 || size.y <= 0) continue;
+void DungeonGenerator::AddCorridor(std::vector<DungeonRoom>& rooms, const Corridor& corridor, int room0Idx, int room1Idx)
+{
+	// The color of corridors
+	constexpr Color corridorColor{ 255, 127, 127 };
 
-		// Create a new room
-		DungeonRoom newRoom
-		{
-			bottomLeft,
-			size,
-			corridorColor
-		};
+	// Every part is connected to the room or part before it and after it
+	int prevIdx{ room0Idx };
+	for (int part{}; part < corridor.nrParts; ++part)
+	{
+		// The index of the new corridor
+		const int corridorIdx{ static_cast<int>(rooms.size()) };
 
-		// Add the neighbouring rooms to the connections of the corridor
-		newRoom.AddConnection(edge.p0.second);
-		newRoom.AddConnection(edge.p1.second);
+		// Connect the corridor and the room or part before it
+		m_ConnectionLinks.emplace_back(corridorIdx, prevIdx);
+		m_ConnectionLinks.emplace_back(prevIdx, corridorIdx);
 
 		// Add the corridor to the list of rooms
-		rooms.push_back(newRoom);
+		rooms.emplace_back(corridor.positions[part], corridor.sizes[part], corridorColor);
+		Notify(GenerationEvent{ GenerationEventType::CorridorCreated, corridorIdx, { room0Idx, room1Idx }, corridor.positions[part], corridor.sizes[part] });
+		Notify(GenerationEvent{ GenerationEventType::RoomsConnected, 0, { prevIdx, corridorIdx } });
 
-		// Add the new room to the connections of the neighbouring rooms
-		room0.AddConnection(static_cast<int>(rooms.size() - 1));
-		room1.AddConnection(static_cast<int>(rooms.size() - 1));
+		prevIdx = corridorIdx;
 	}
+
+	// Connect the last part and room 1
+	m_ConnectionLinks.emplace_back(prevIdx, room1Idx);
+	m_ConnectionLinks.emplace_back(room1Idx, prevIdx);
+	Notify(GenerationEvent{ GenerationEventType::RoomsConnected, 0, { prevIdx, room1Idx } });
 }
 
-void DungeonGenerator::ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms) const
+void DungeonGenerator::ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms, const AdjacencyList& connections)
 {
+	// Count the connections of every room in the MST
+	m_RoomDegrees.assign(rooms.size(), 0);
+	for (const Edge& edge : m_MinimumSpanningTree)
+	{
+		++m_RoomDegrees[edge.p0.second];
+		++m_RoomDegrees[edge.p1.second];
+	}
+
 	// The index of the start room
 	int startIdx{ -1 };
 	
 	// The current greatest distance
-	int distanceFromStart{ 0 };
+	long long distanceFromStart{ 0 };
 
 	// The index of the end room
 	int endIdx{ -1 };
@@ -682,31 +1381,23 @@ void DungeonGenerator::ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms) co
 	// For each room
 	for (int i{}; i < rooms.size(); ++i)
 	{
-		// The number of connections this room has
-		int nrConnections{};
-
-		// For each edge in the MST
-		for (const Edge& edge : m_MinimumSpanningTree)
-		{
-			// If the edge contains this room, increment the number of connections
-			if (edge.p0.second == i || edge.p1.second == i)
-				++nrConnections;
-		}
-
 		// If this room is not a leaf room, continue to the next room
-		if (nrConnections != 1) continue;
+		if (m_RoomDegrees[i] != 1) continue;
 
 		if (startIdx == -1)
 		{
 			// If a start room has not been found, set the start room to the current room
 			startIdx = i;
+
+			// The longest path only needs a leaf room to start searching from
+			if (m_IsUsingLongestPath) break;
 		}
 		else
 		{
 			// If a start room has been found
 
 			// Calculate the distance between the start and end room
-			const int curDistanceFromStart{ rooms[i].GetPosition().DistanceSqr(rooms[startIdx].GetPosition()) };
+			const long long curDistanceFromStart{ rooms[i].GetPosition().DistanceSqr(rooms[startIdx].GetPosition()) };
 
 			// If the calculated distance is greater then the current greatest distance
 			if (curDistanceFromStart > distanceFromStart)
@@ -718,9 +1409,79 @@ void DungeonGenerator::ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms) co
 		}
 	}
 
+	// Without a leaf room at both ends, the dungeon has no start or end room
+	if (startIdx < 0 || (endIdx < 0 && !m_IsUsingLongestPath)) return;
+
+	if (m_IsUsingLongestPath)
+	{
+		// The dungeon is a tree, the leaf room furthest away from any room is one end of its longest path
+		// The leaf room furthest away from that end is the other end
+		const int firstEndIdx{ FindFurthestLeafRoom(connections, startIdx) };
+		const int secondEndIdx{ FindFurthestLeafRoom(connections, firstEndIdx) };
+
+		startIdx = firstEndIdx;
+		endIdx = secondEndIdx;
+	}
+
 	// Set the properties of the start and end room
 	rooms[startIdx].SetColor(Color{ 255, 215, 0 });	// Gold color
 	rooms[startIdx].SetRoomType(DungeonRoom::DungeonRoomType::Start);
 	rooms[endIdx].SetColor(Color{ 50, 50, 50 }); // Dark gray color
 	rooms[endIdx].SetRoomType(DungeonRoom::DungeonRoomType::End);
+	Notify(GenerationEvent{ GenerationEventType::StartAndEndChosen, 0, { startIdx, endIdx } });
+}
+
+int DungeonGenerator::FindFurthestLeafRoom(const AdjacencyList& connections, int roomIdx)
+{
+	// Calculate the amount of steps to every room with a breadth first search
+	m_RoomDistances.assign(connections.GetNrVertices(), -1);
+	m_OpenRooms.clear();
+
+	m_RoomDistances[roomIdx] = 0;
+	m_OpenRooms.push_back(roomIdx);
+
+	// The furthest leaf room, the room itself if no other leaf room can be reached
+	int furthestIdx{ roomIdx };
+
+	for (size_t i{}; i < m_OpenRooms.size(); ++i)
+	{
+		const int curRoomIdx{ m_OpenRooms[i] };
+
+		// Keep the first leaf room that has been found at the greatest distance
+		if (m_RoomDegrees[curRoomIdx] == 1 && m_RoomDistances[curRoomIdx] > m_RoomDistances[furthestIdx])
+		{
+			furthestIdx = curRoomIdx;
+		}
+
+		for (int connection : connections.GetNeighbours(curRoomIdx))
+		{
+			if (m_RoomDistances[connection] >= 0) continue;
+
+			m_RoomDistances[connection] = m_RoomDistances[curRoomIdx] + 1;
+			m_OpenRooms.push_back(connection);
+		}
+	}
+
+	return furthestIdx;
+}
+
+void DungeonGenerator::NotifyRoom(GenerationEventType type, int roomIdx) const
+{
+	if (!m_pListener) return;
+
+	m_pListener->OnGenerationEvent(GenerationEvent{ type, roomIdx, {}, m_RoomStore.GetPosition(roomIdx), m_RoomStore.GetSize(roomIdx) });
+}
+
+void DungeonGenerator::NotifyRoomsMoved()
+{
+	// Report every room that isn't at the position it had before the pass
+	for (int i{}; i < m_RoomStore.GetCount(); ++i)
+	{
+		const Vector2 position{ m_RoomStore.GetPosition(i) };
+		if (position == m_PrevRoomPositions[i]) continue;
+
+		m_pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::RoomMoved, i, {}, position });
+	}
+
+	m_pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::SeperationPassFinished, m_CurSeperationPass });
 }
@@ -4,8 +4,15 @@
 // Include Files
 //-----------------------------------------------------
 #include <vector>
+#include <chrono>
+#include <atomic>
 #include "DungeonRoom.h"
 #include "DelaunayTriangulation.h"
+#include "SpatialHashGrid.h"
+#include "RoomStore.h"
+#include "RoomKernel.h"
+#include "GenerationListener.h"
+#include "Utils.h"
 
 //-----------------------------------------------------
 // DungeonGenerator Class									
@@ -13,69 +20,220 @@
 class DungeonGenerator final
 {
 public:
-	DungeonGenerator();				// Constructor
+	enum class GenerationCycleState
+	{
+		CIRCLE,
+		SEPERATION,
+		DISCARD_SMALL_ROOMS,
+		DISCARD_BORDERING_ROOMS,
+		TRIANGULATION,
+		SPANNING_TREE_ALGORITHM,
+		CORRIDORS,
+		DONE
+	};
+
+	// How overlapping rooms are pushed apart
+	enum class SeperationMode
+	{
+		// Every overlapping room pushes the room a few units away from its center, this gives the classic look
+		Steering,
+		// Every overlapping room pushes the room out along its shortest way out, this needs a lot less passes
+		MinimumTranslation
+	};
+
+	// Measurements of the last generated dungeon, including every retry
+	struct GenerationStatistics
+	{
+		double stageSeconds[static_cast<int>(GenerationCycleState::DONE)]{};
+		int nrSeperationIterations{};
+		int nrRetries{};
+		// Spanning tree edges without a corridor that fits between the two rooms, these rooms are connected by a corridor that crosses a room
+		int nrBlockedCorridors{};
+	};
+
+	// Every setting that changes the layout, generations with equal settings and a seed of 0 or more create the same layout
+	struct LayoutSettings
+	{
+		int seed{ -1 };
+		Vector2 center{};
+		int initRadius{};
+		int initRoomCount{};
+		Vector2 roomSizeBounds{};
+		int roomSizeThreshold{};
+		SeperationMode seperationMode{};
+		bool isUsingLongestPath{};
+
+		bool operator==(const LayoutSettings& other) const;
+	};
+
+	DungeonGenerator() = default;	// Constructor
 	~DungeonGenerator() = default;	// Destructor
 
 	//-------------------------------------------------
 	// Member functions						
 	//-------------------------------------------------
-	void GenerateDungeon(std::vector<DungeonRoom>& rooms);
-	void Update(std::vector<DungeonRoom>& rooms);
+	void GenerateDungeon(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
+	void Update(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
 
 	void SetSeed(int seed) { m_CurrentSeed = seed; }
-	void SetInitialRadius(int initRadius) { m_InitRadius = initRadius; }
+	void SetCenter(const Vector2& center) { m_Center = center; }
+	// Clamped to the max initial radius
+	void SetInitialRadius(int initRadius);
 	void SetInitialRoomCount(int initRoomCount) { m_InitRoomCount = initRoomCount; }
 	void SetRoomSizeBounds(int minSize, int maxSize);
 	void SetGenerationState(bool isSlowlyGenerating) { m_IsSlowlyGenerating = isSlowlyGenerating; }
 	void SetRoomSizeThreshold(int size) { m_RoomSizeThreshold = size; }
+	void SetBroadphaseState(bool isUsingBroadphase) { m_IsUsingBroadphase = isUsingBroadphase; }
+	void SetInstructionSet(RoomKernel::InstructionSet instructionSet) { m_InstructionSet = RoomKernel::ClampInstructionSet(instructionSet); }
+	void SetLongestPathState(bool isUsingLongestPath) { m_IsUsingLongestPath = isUsingLongestPath; }
+	void SetSeperationMode(SeperationMode seperationMode) { m_SeperationMode = seperationMode; }
+	// The time slow generation may spend per update, 0 runs exactly one step per update
+	void SetStepTimeBudget(float milliseconds) { m_StepTimeBudget = max(milliseconds, 0.0f); }
+	// Slow generation runs every step before this stage in a single update, the animation continues from this stage
+	void SkipToStage(GenerationCycleState state) { m_SkipToState = state; }
+	// Stops a generation that runs on another thread as soon as possible, this generator leaves every later dungeon empty
+	void Cancel() { m_IsCancelled = true; }
+	// Reports every change of the next generations to the listener, nullptr stops reporting
+	void SetListener(GenerationListener* pListener);
 
+#ifndef DUNGEON_HEADLESS
 	void DrawDebug() const;
+#endif
 	bool IsDone() const;
+	bool IsCancelled() const { return m_IsCancelled; }
+	GenerationCycleState GetGenerationState() const { return m_CurrentGenerationState; }
+	float GetStepTimeBudget() const { return m_StepTimeBudget; }
 	int GetInitialRoomCount() const;
 	int GetInitialRadius() const;
+	RandomGenerator& GetRandomGenerator() { return m_Random; }
+	RoomKernel::InstructionSet GetInstructionSet() const { return m_InstructionSet; }
+	SeperationMode GetSeperationMode() const { return m_SeperationMode; }
+	const GenerationStatistics& GetStatistics() const { return m_Statistics; }
+	LayoutSettings GetLayoutSettings() const;
+	const std::vector<Edge>& GetMinimumSpanningTree() const { return m_MinimumSpanningTree; }
+	GenerationListener* GetListener() const { return m_pListener; }
+	static const char* GetStageName(GenerationCycleState state);
+	// The biggest initial radius the generator supports, every coordinate and every difference between two room centers stays far inside the range of an int
+	static int GetMaxInitialRadius() { return 100000000; }
 	
 private:
 	//-------------------------------------------------
 	// Private member functions								
 	//-------------------------------------------------
-	void CreateRoomsInCircle(std::vector<DungeonRoom>& rooms) const;
-	void CreateRoomInCircle(std::vector<DungeonRoom>& rooms) const;
-	bool SeperateRooms(std::vector<DungeonRoom>& rooms) const;
-	bool DiscardSmallRooms(std::vector<DungeonRoom>& rooms, bool debug = false);
-	bool DiscardBorderingRooms(std::vector<DungeonRoom>& rooms, bool debug = false);
+	// A corridor between two rooms, a straight corridor has 1 part and a bent corridor has up to 2 parts
+	struct Corridor
+	{
+		Vector2 positions[2]{};
+		Vector2 sizes[2]{};
+		int nrParts{};
+	};
+
+	void StartGeneration(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
+	void UpdateStep(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
+	bool RetryFailedStages(std::vector<DungeonRoom>& rooms);
+	bool StopIfCancelled(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
+	void AddStageTime(GenerationCycleState state, std::chrono::steady_clock::time_point& stageStart);
+	void CreateRoomsInCircle();
+	void CreateRoomInCircle();
+	bool SeperateRooms();
+	bool SeperateRoomsBruteForce();
+	bool SeperateRoomsBroadphase();
+	bool SeperateRoomsMinimumTranslation();
+	void SpreadRooms();
+	void DiscardSmallRooms();
+	void DiscardBorderingRooms();
 	void CreateMinimumSpanningTree();
-	void CreateCorridors(std::vector<DungeonRoom>& rooms) const;
-	void ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms) const;
+	void CreateCorridors(std::vector<DungeonRoom>& rooms, AdjacencyList& connections);
+	bool CreateStraightCorridor(const DungeonRoom& room0, const DungeonRoom& room1, Corridor& corridor) const;
+	bool CreateBentCorridor(const DungeonRoom& room0, const DungeonRoom& room1, bool isHorizontalFirst, bool isCutByRooms, Corridor& corridor) const;
+	bool IsCorridorFree(const std::vector<DungeonRoom>& rooms, const Corridor& corridor, int room0Idx, int room1Idx);
+	void AddCorridor(std::vector<DungeonRoom>& rooms, const Corridor& corridor, int room0Idx, int room1Idx);
+	void ChooseBeginAndEndRoom(std::vector<DungeonRoom>& rooms, const AdjacencyList& connections);
+	int FindFurthestLeafRoom(const AdjacencyList& connections, int roomIdx);
+	void Notify(const GenerationEvent& event) const { if (m_pListener) m_pListener->OnGenerationEvent(event); }
+	void NotifyRoom(GenerationEventType type, int roomIdx) const;
+	void NotifyRoomsMoved();
 
 	//-------------------------------------------------
 	// Datamembers								
 	//-------------------------------------------------
-	enum class GenerationCycleState
-	{
-		CIRCLE,
-		SEPERATION,
-		DISCARD_SMALL_ROOMS,
-		DISCARD_BORDERING_ROOMS,
-		TRIANGULATION,
-		SPANNING_TREE_ALGORITHM,
-		CORRIDORS,
-		DONE
-	};
-
 	bool m_IsGenerating{};
 	int m_CurrentSeed{ -1 };
+	uint64_t m_GenerationSeed{};
+	RandomGenerator m_Random{};
 
-	const Vector2 m_Center{ 300, 300 };
+	Vector2 m_Center{ 300, 300 };
 	int m_InitRadius{ 100 };
 	int m_InitRoomCount{ 200 };
 	Vector2 m_RoomSizeBounds{ 4, 40 };
 	int m_RoomSizeThreshold{ 30 };
+	// The threshold of the current generation, lowered when every room has been discarded
+	int m_CurRoomSizeThreshold{ 30 };
 	int m_CurTriangulateRoom{};
 
+	// The geometry of the rooms during the circle, seperation and discard stages
+	RoomStore m_RoomStore{};
+	// The rooms right after the seperation, a failed discard or triangulation retries from these rooms
+	RoomStore m_SeperatedRoomStore{};
+
 	std::vector<DungeonRoom> m_DebugRooms{};
+	// Scratch data of the discard stages, the rooms that are removed
+	std::vector<bool> m_IsRoomDiscarded{};
 	std::vector<Edge> m_MinimumSpanningTree{};
 
+	// Scratch data of the minimum spanning tree algorithm
+	struct ForestTree
+	{
+		int firstEdge{ -1 };
+		int lastEdge{ -1 };
+		int forestIdx{};
+	};
+	std::vector<Edge> m_TriangulationEdges{};
+	DisjointSet m_Vertices{};
+	std::vector<int> m_VertexTrees{};
+	std::vector<ForestTree> m_Trees{};
+	std::vector<int> m_Forest{};
+	std::vector<int> m_NextTreeEdges{};
+
+	// The connections made by the corridors, as (room, connected room) links
+	std::vector<std::pair<int, int>> m_ConnectionLinks{};
+
 	DelaunayTriangulation m_Triangulation{};
+
+	SeperationMode m_SeperationMode{ SeperationMode::Steering };
+	// The amount of seperation passes since the rooms were created, seperation stops after too many passes
+	int m_CurSeperationPass{};
+
+	bool m_IsUsingBroadphase{ true };
+	SpatialHashGrid m_RoomGrid{};
+	std::vector<int> m_NearbyRooms{};
+	// The rooms sorted by the left side of the room as (x, room) pairs, tests large corridors without walking every cell they cover
+	std::vector<std::pair<int, int>> m_RoomsByX{};
+	int m_MaxRoomWidth{};
+
+	// The instruction set used to test a room against every other room, the widest supported one by default
+	RoomKernel::InstructionSet m_InstructionSet{ RoomKernel::ClampInstructionSet(RoomKernel::InstructionSet::AVX2) };
+
+	// Whether the start and end room are the ends of the longest path in the dungeon, instead of the leaf rooms furthest apart
+	bool m_IsUsingLongestPath{};
+	// Scratch data to choose the start and end room
+	std::vector<int> m_RoomDegrees{};
+	std::vector<int> m_RoomDistances{};
+	std::vector<int> m_OpenRooms{};
+
 	GenerationCycleState m_CurrentGenerationState{};
 	bool m_IsSlowlyGenerating{};
+	// The time in milliseconds slow generation may spend per update
+	float m_StepTimeBudget{};
+	// Every stage before this stage is generated without waiting for the next update
+	GenerationCycleState m_SkipToState{};
+	// Set from another thread to stop the generation
+	std::atomic<bool> m_IsCancelled{};
+
+	GenerationStatistics m_Statistics{};
+
+	// Receives every change of the generation, without a listener no events are created
+	GenerationListener* m_pListener{};
+	// The positions of the rooms before the current seperation pass, only kept while there is a listener
+	std::vector<Vector2> m_PrevRoomPositions{};
 };
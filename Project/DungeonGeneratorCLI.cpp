@@ -0,0 +1,303 @@
+//-----------------------------------------------------------------
+// Headless batch generator
+// Generates a range of seeded dungeons without the game engine
+//-----------------------------------------------------------------
+
+//---------------------------
+// Includes
+//---------------------------
+#include "DungeonBatchGenerator.h"
+#include "DungeonLibrary.h"
+#include "DungeonLibraryWriter.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+
+//---------------------------
+// Parameters
+//---------------------------
+struct GenerationParameters
+{
+	int firstSeed{ 0 };
+	int lastSeed{ 0 };
+	int initRadius{ 100 };
+	int initRoomCount{ 200 };
+	int nrKeys{ 0 };
+	bool needAllKeys{ true };
+	bool isUsingLongestPath{ false };
+	DungeonGenerator::SeperationMode seperationMode{ DungeonGenerator::SeperationMode::Steering };
+	int nrThreads{ 0 };
+	bool isWritingBinary{ false };
+	std::string outputPath{};
+	std::string libraryPath{};
+	int lastSweepNrKeys{ -1 };
+};
+
+//---------------------------
+// Functions
+//---------------------------
+void PrintUsage()
+{
+	std::cerr
+		<< "Usage: GPP_Research_DungeonGeneratorCLI [options]\n"
+		<< "  --seeds <first> <last>    Range of seeds to generate (default 0 0)\n"
+		<< "  --radius <radius>         Initial radius of the room circle, at most 100000000 (default 100)\n"
+		<< "  --rooms <count>           Initial amount of rooms (default 200)\n"
+		<< "  --keys <count>            Amount of keys and locked rooms (default 0)\n"
+		<< "  --need-all-keys <0|1>     Whether all keys are needed to solve the dungeon (default 1)\n"
+		<< "  --longest-path <0|1>      Whether the start and end are the ends of the longest path (default 0)\n"
+		<< "  --seperation <steering|mtv>  How overlapping rooms are pushed apart (default steering)\n"
+		<< "  --threads <count>         Amount of worker threads, 0 uses every core (default 0)\n"
+		<< "  --format <text|binary>    Write the dungeons as text or as a binary library, binary needs --output\n"
+		<< "                            and can't be combined with --read or --key-sweep (default text)\n"
+		<< "  --output <file>           File to write the dungeons to (default standard output)\n"
+		<< "  --read <file>             Write the dungeons of a binary library as text instead of generating them\n"
+		<< "  --key-sweep <count>       Place 0 up to count keys in the layout of every seed and write whether it can be solved\n";
+}
+
+bool ReadParameters(int argc, char* argv[], GenerationParameters& parameters)
+{
+	try
+	{
+		for (int i{ 1 }; i < argc; ++i)
+		{
+			const std::string argument{ argv[i] };
+
+			// The amount of values that should follow this argument
+			const int nrValues{ argument == "--seeds" ? 2 : 1 };
+			if (i + nrValues >= argc) return false;
+
+			if (argument == "--seeds")
+			{
+				parameters.firstSeed = std::stoi(argv[++i]);
+				parameters.lastSeed = std::stoi(argv[++i]);
+			}
+			else if (argument == "--radius")
+			{
+				parameters.initRadius = std::stoi(argv[++i]);
+			}
+			else if (argument == "--rooms")
+			{
+				parameters.initRoomCount = std::stoi(argv[++i]);
+			}
+			else if (argument == "--keys")
+			{
+				parameters.nrKeys = std::stoi(argv[++i]);
+			}
+			else if (argument == "--need-all-keys")
+			{
+				parameters.needAllKeys = std::stoi(argv[++i]) != 0;
+			}
+			else if (argument == "--longest-path")
+			{
+				parameters.isUsingLongestPath = std::stoi(argv[++i]) != 0;
+			}
+			else if (argument == "--seperation")
+			{
+				const std::string mode{ argv[++i] };
+				if (mode == "steering") parameters.seperationMode = DungeonGenerator::SeperationMode::Steering;
+				else if (mode == "mtv") parameters.seperationMode = DungeonGenerator::SeperationMode::MinimumTranslation;
+				else return false;
+			}
+			else if (argument == "--threads")
+			{
+				parameters.nrThreads = std::stoi(argv[++i]);
+			}
+			else if (argument == "--format")
+			{
+				const std::string format{ argv[++i] };
+				if (format == "text") parameters.isWritingBinary = false;
+				else if (format == "binary") parameters.isWritingBinary = true;
+				else return false;
+			}
+			else if (argument == "--output")
+			{
+				parameters.outputPath = argv[++i];
+			}
+			else if (argument == "--read")
+			{
+				parameters.libraryPath = argv[++i];
+			}
+			else if (argument == "--key-sweep")
+			{
+				parameters.lastSweepNrKeys = std::stoi(argv[++i]);
+				if (parameters.lastSweepNrKeys < 0) return false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+	catch (const std::logic_error&)
+	{
+		// One of the values is not a number
+		return false;
+	}
+
+	// Negative seeds would use the current time, which makes the output unreproducable
+	// A binary library can't be written to the standard output
+	// Reading a library and sweeping the keys only write text
+	return parameters.firstSeed >= 0 && parameters.lastSeed >= parameters.firstSeed &&
+		parameters.initRadius > 0 && parameters.initRadius <= DungeonGenerator::GetMaxInitialRadius() && parameters.initRoomCount > 0 && parameters.nrKeys >= 0 && parameters.nrThreads >= 0 &&
+		(!parameters.isWritingBinary || (!parameters.outputPath.empty() && parameters.libraryPath.empty() && parameters.lastSweepNrKeys < 0));
+}
+
+void WriteDungeon(std::ostream& output, int seed, const Dungeon& dungeon)
+{
+	const std::vector<DungeonRoom>& rooms{ dungeon.GetRooms() };
+
+	output << "dungeon " << seed << " rooms " << rooms.size() << " start " << dungeon.GetStartRoom() << " end " << dungeon.GetEndRoom() << '\n';
+
+	// Write every room as "room index x y width height type connections..."
+	for (size_t i{}; i < rooms.size(); ++i)
+	{
+		const DungeonRoom& room{ rooms[i] };
+		output << "room " << i << ' ' << room.GetPosition().x << ' ' << room.GetPosition().y << ' '
+			<< room.GetSize().x << ' ' << room.GetSize().y << ' ' << static_cast<int>(room.GetRoomType());
+
+		for (int connection : dungeon.GetRoomConnectionsFromIndex(static_cast<int>(i)))
+		{
+			output << ' ' << connection;
+		}
+		output << '\n';
+	}
+}
+
+void WriteDungeon(std::ostream& output, const DungeonView& dungeon)
+{
+	const DungeonRecordHeader& header{ *dungeon.pHeader };
+
+	output << "dungeon " << header.seed << " rooms " << header.nrRooms << " start " << header.startRoom << " end " << header.endRoom << '\n';
+
+	// Write every room in the same format as a generated dungeon
+	for (int i{}; i < header.nrRooms; ++i)
+	{
+		const DungeonRoomRecord& room{ dungeon.pRooms[i] };
+		output << "room " << i << ' ' << room.x << ' ' << room.y << ' ' << room.width << ' ' << room.height << ' ' << room.type;
+
+		for (int connectionIdx{ dungeon.pConnectionOffsets[i] }; connectionIdx < dungeon.pConnectionOffsets[i + 1]; ++connectionIdx)
+		{
+			output << ' ' << dungeon.pConnections[connectionIdx];
+		}
+		output << '\n';
+	}
+}
+
+bool WriteLibrary(std::ostream& output, const std::string& path)
+{
+	DungeonLibrary library{};
+	if (!library.Open(path))
+	{
+		std::cerr << "Couldn't open the library " << path << '\n';
+		return false;
+	}
+
+	for (int i{}; i < library.GetCount(); ++i)
+	{
+		DungeonView dungeon{};
+		if (!library.GetDungeon(i, dungeon))
+		{
+			std::cerr << "Dungeon " << i << " of the library is broken\n";
+			return false;
+		}
+
+		WriteDungeon(output, dungeon);
+	}
+
+	return true;
+}
+
+void WriteKeySweep(std::ostream& output, const GenerationParameters& parameters)
+{
+	// The layout of every seed is generated once, every amount of keys is placed in that layout
+	const std::shared_ptr<Dungeon> pDungeon{ std::make_shared<Dungeon>() };
+	DungeonGenerator& generator{ pDungeon->GetGenerator() };
+	generator.SetInitialRadius(parameters.initRadius);
+	generator.SetInitialRoomCount(parameters.initRoomCount);
+	generator.SetGenerationState(false);
+	generator.SetLongestPathState(parameters.isUsingLongestPath);
+	generator.SetSeperationMode(parameters.seperationMode);
+	pDungeon->SetKeyCount(0);
+	pDungeon->SetNeedAllKeys(parameters.needAllKeys);
+
+	std::vector<Dungeon::KeySweepResult> results{};
+	// Loop over the offsets from the first seed, a seed counter would overflow after a last seed of INT_MAX
+	for (int i{}; i <= parameters.lastSeed - parameters.firstSeed; ++i)
+	{
+		const int seed{ parameters.firstSeed + i };
+		generator.SetSeed(seed);
+		pDungeon->GenerateDungeon();
+		pDungeon->Update();
+
+		// Write every amount of keys as "sweep seed keys count placed count solved 0|1 steps count"
+		pDungeon->SweepKeyCounts(0, parameters.lastSweepNrKeys, results);
+		for (const Dungeon::KeySweepResult& result : results)
+		{
+			output << "sweep " << seed << " keys " << result.nrKeys << " placed " << result.nrPlacedKeys
+				<< " solved " << (result.isSolved ? 1 : 0) << " steps " << result.nrSolveSteps << '\n';
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	GenerationParameters parameters{};
+	if (!ReadParameters(argc, argv, parameters))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	// Open the output file, or use the standard output
+	std::ofstream outputFile{};
+	if (!parameters.outputPath.empty() && !parameters.isWritingBinary)
+	{
+		outputFile.open(parameters.outputPath);
+		if (!outputFile)
+		{
+			std::cerr << "Couldn't open the output file " << parameters.outputPath << '\n';
+			return 1;
+		}
+	}
+	std::ostream& output{ parameters.outputPath.empty() ? std::cout : outputFile };
+
+	// Read the dungeons from a library instead of generating them
+	if (!parameters.libraryPath.empty())
+	{
+		return WriteLibrary(output, parameters.libraryPath) ? 0 : 1;
+	}
+
+	// Sweep the amount of keys instead of writing the dungeons
+	if (parameters.lastSweepNrKeys >= 0)
+	{
+		WriteKeySweep(output, parameters);
+		return 0;
+	}
+
+	DungeonParameters dungeonParameters{};
+	dungeonParameters.initRadius = parameters.initRadius;
+	dungeonParameters.initRoomCount = parameters.initRoomCount;
+	dungeonParameters.nrKeys = parameters.nrKeys;
+	dungeonParameters.needAllKeys = parameters.needAllKeys;
+	dungeonParameters.isUsingLongestPath = parameters.isUsingLongestPath;
+	dungeonParameters.seperationMode = parameters.seperationMode;
+
+	// Generate the dungeons on every thread, they are written in the order of the seeds
+	DungeonBatchGenerator batchGenerator{ dungeonParameters, parameters.nrThreads };
+	DungeonLibraryWriter libraryWriter{};
+	batchGenerator.Generate(parameters.firstSeed, parameters.lastSeed, [&](int seed, const Dungeon& dungeon)
+		{
+			if (parameters.isWritingBinary) libraryWriter.Add(seed, dungeonParameters, dungeon);
+			else WriteDungeon(output, seed, dungeon);
+		});
+
+	// The whole library is written at once
+	if (parameters.isWritingBinary && !libraryWriter.Write(parameters.outputPath))
+	{
+		std::cerr << "Couldn't write the library " << parameters.outputPath << '\n';
+		return 1;
+	}
+
+	return 0;
+}
@@ -8,6 +8,7 @@
 //-----------------------------------------------------------------
 #include "DungeonGeneratorMain.h"																				
 #include "Camera.h"
+#include <iomanip>
 
 //-----------------------------------------------------------------
 // DungeonGeneratorMain methods																				
@@ -37,15 +38,20 @@ void DungeonGeneratorMain::Initialize(HINSTANCE hInstance)
 
 	// Set the required camera values
 	CAMERA->SetCenter({ GAME_ENGINE->GetWidth() / 2, GAME_ENGINE->GetHeight() / 2 });
+	CAMERA->SetScreenSize({ GAME_ENGINE->GetWidth(), GAME_ENGINE->GetHeight() });
 }
 
 void DungeonGeneratorMain::Start()
 {
-	// New seed for the random positions
-	srand(static_cast<unsigned int>(time(NULL)));
+#ifdef DUNGEON_PROFILING
+	// The overlay counts from the first generation
+	m_GenerationProfile = Profiler::TakeSnapshot();
+	m_PrevFrameProfile = m_GenerationProfile;
+#endif
 
-	// Create dungeon
+	// Create dungeon, the rooms are generated around the center of the window
 	m_pDungeon = std::make_shared<Dungeon>();
+	m_pDungeon->GetGenerator().SetCenter({ GAME_ENGINE->GetWidth() / 2, GAME_ENGINE->GetHeight() / 2 });
 	m_pDungeon->GenerateDungeon();
 
 	// Retrieve the generator from the dungeon
@@ -111,8 +117,29 @@ void DungeonGeneratorMain::KeyPressed(TCHAR cKey)
 
 void DungeonGeneratorMain::Paint(RECT rect)
 {
+	PROFILE_SCOPE(Paint);
+
 	// Draw the dungeon
-	m_pDungeon->Draw();
+	if (m_pDungeon->GetGenerator().IsDone())
+	{
+		// The layout of a finished dungeon doesn't move, draw it again only if it is not the dungeon in the cached layer anymore
+		const bool isLayerOutdated{ !m_IsDungeonLayerValid || m_DungeonLayerVersion != m_pDungeon->GetDrawVersion() || m_CameraLayerVersion != CAMERA->GetVersion() };
+		if (isLayerOutdated && GAME_ENGINE->BeginCachedLayer())
+		{
+			m_pDungeon->Draw();
+			GAME_ENGINE->EndCachedLayer();
+
+			m_IsDungeonLayerValid = true;
+			m_DungeonLayerVersion = m_pDungeon->GetDrawVersion();
+			m_CameraLayerVersion = CAMERA->GetVersion();
+		}
+
+		GAME_ENGINE->DrawCachedLayer();
+	}
+	else
+	{
+		m_pDungeon->Draw();
+	}
 
 	// Draw extra UI text
 	GAME_ENGINE->SetColor(RGB(255, 255, 255));
@@ -122,16 +149,46 @@ void DungeonGeneratorMain::Paint(RECT rect)
 	GAME_ENGINE->DrawString(_T("Init Room Count:"), GAME_ENGINE->GetWidth() - 206, GAME_ENGINE->GetHeight() - 178);
 	GAME_ENGINE->DrawString(_T("Key Count:"), GAME_ENGINE->GetWidth() - 169, GAME_ENGINE->GetHeight() - 218);
 	GAME_ENGINE->DrawString(_T("Needs All Keys:"), GAME_ENGINE->GetWidth() - 163, GAME_ENGINE->GetHeight() - 258);
+	GAME_ENGINE->DrawString(_T("Longest Path:"), GAME_ENGINE->GetWidth() - 151, GAME_ENGINE->GetHeight() - 298);
+	GAME_ENGINE->DrawString(_T("MTV Seperation:"), GAME_ENGINE->GetWidth() - 163, GAME_ENGINE->GetHeight() - 338);
+	GAME_ENGINE->DrawString(_T("Step Budget (ms):"), GAME_ENGINE->GetWidth() - 214, GAME_ENGINE->GetHeight() - 378);
+#ifdef DUNGEON_PROFILING
+	GAME_ENGINE->DrawString(_T("Profiler Overlay:"), GAME_ENGINE->GetWidth() - 179, GAME_ENGINE->GetHeight() - 418);
+#endif
+
+	if (m_GenerationThread.IsGenerating())
+	{
+		GAME_ENGINE->DrawString(_T("Generating..."), 30, GAME_ENGINE->GetHeight() - 60);
+	}
 
 	GAME_ENGINE->SetColor(RGB(255, 0, 0));
 	GAME_ENGINE->DrawString(m_ErrorMessage, 30, GAME_ENGINE->GetHeight() - 30);
 
 	// Draw the dungeon solver
 	m_pDungeonSolver->Draw();
+
+#ifdef DUNGEON_PROFILING
+	// Draw the profiler overlay on top of everything
+	if (m_pProfilerCheckBox->IsChecked()) DrawProfiler();
+#endif
 }
 
 void DungeonGeneratorMain::Tick(float elapsedSec)
 {
+	PROFILE_SCOPE(Tick);
+
+#ifdef DUNGEON_PROFILING
+	// Count the heap allocations of the last frame, on every thread
+	const Profiler::Snapshot frameProfile{ Profiler::TakeSnapshot() };
+	m_NrFrameAllocations = frameProfile.counts[static_cast<int>(Profiler::Counter::HeapAllocations)] - m_PrevFrameProfile.counts[static_cast<int>(Profiler::Counter::HeapAllocations)];
+	m_PrevFrameProfile = frameProfile;
+	m_FrameSeconds = elapsedSec;
+#endif
+
+	// Show the dungeon of the generation thread once it is done
+	const std::shared_ptr<Dungeon> pFinishedDungeon{ m_GenerationThread.TakeFinishedDungeon() };
+	if (pFinishedDungeon) SetDungeon(pFinishedDungeon);
+
 	// Update the dungeon
 	m_pDungeon->Update();
 
@@ -146,8 +203,15 @@ void DungeonGeneratorMain::CallAction(Caller* callerPtr)
 		// Clear the error message
 		m_ErrorMessage.clear();
 
-		// Retrieve the generator from the dungeon
-		DungeonGenerator& generator{ m_pDungeon->GetGenerator() };
+#ifdef DUNGEON_PROFILING
+		// The overlay shows the counters of this generation
+		m_GenerationProfile = Profiler::TakeSnapshot();
+#endif
+
+		// Create the new dungeon, the rooms are generated around the center of the window
+		const std::shared_ptr<Dungeon> pDungeon{ std::make_shared<Dungeon>() };
+		DungeonGenerator& generator{ pDungeon->GetGenerator() };
+		generator.SetCenter({ GAME_ENGINE->GetWidth() / 2, GAME_ENGINE->GetHeight() / 2 });
 
 		// The seed for the generation
 		int seed{ -1 };
@@ -176,7 +240,12 @@ void DungeonGeneratorMain::CallAction(Caller* callerPtr)
 			try
 			{
 				const int radius{ std::stoi(m_pInitRadiusTextBox->GetText()) };
-				if (radius > 0)
+				if (radius > DungeonGenerator::GetMaxInitialRadius())
+				{
+					// Display an error message
+					m_ErrorMessage = _T("Initial radius can't be more then 100000000");
+				}
+				else if (radius > 0)
 				{
 					// Set the initial radius of the dungeon generator
 					generator.SetInitialRadius(radius);
@@ -227,7 +296,7 @@ void DungeonGeneratorMain::CallAction(Caller* callerPtr)
 				if (keyCount >= 0)
 				{
 					// Set the key count of the dungeon generator
-					m_pDungeon->SetKeyCount(keyCount);
+					pDungeon->SetKeyCount(keyCount);
 				}
 				else
 				{
@@ -242,21 +311,87 @@ void DungeonGeneratorMain::CallAction(Caller* callerPtr)
 			}
 		}
 
+		// Get the time budget of every slow generation update from the textbox
+		if (!m_pStepTimeBudgetTextBox->GetText().empty())
+		{
+			try
+			{
+				const float timeBudget{ std::stof(m_pStepTimeBudgetTextBox->GetText()) };
+				if (timeBudget >= 0.0f)
+				{
+					// Set the time budget of the dungeon generator
+					generator.SetStepTimeBudget(timeBudget);
+				}
+				else
+				{
+					// Display an error message
+					m_ErrorMessage = _T("Step budget can't be less then 0");
+				}
+			}
+			catch (const logic_error&)
+			{
+				// Display an error message
+				m_ErrorMessage = _T("Couldn't read the step budget textbox");
+			}
+		}
+
 		// Apply the check boxes
 		generator.SetGenerationState(m_pSlowGenerateCheckBox->IsChecked());
-		m_pDungeon->SetNeedAllKeys(m_pNeedAllKeysCheckbox->IsChecked());
+		pDungeon->SetNeedAllKeys(m_pNeedAllKeysCheckbox->IsChecked());
+		generator.SetLongestPathState(m_pLongestPathCheckbox->IsChecked());
+		generator.SetSeperationMode(m_pMinimumTranslationCheckbox->IsChecked() ?
+			DungeonGenerator::SeperationMode::MinimumTranslation : DungeonGenerator::SeperationMode::Steering);
 
-		// Generate the dungeon
-		m_pDungeon->GenerateDungeon();
-
-		// Disable the dungeno solver
-		m_pDungeonSolver->Disable();
+		if (!m_pSlowGenerateCheckBox->IsChecked() && m_pDungeon->HasLayout(generator.GetLayoutSettings()))
+		{
+			// Only the key settings changed, so the keys are placed again in the current layout
+			// Slow generation always generates the whole dungeon again, so it can be watched
+			m_GenerationThread.Cancel();
+			m_pDungeon->SetKeyCount(pDungeon->GetKeyCount());
+			m_pDungeon->SetNeedAllKeys(pDungeon->GetNeedAllKeys());
+			m_pDungeon->RegenerateKeys();
+			SetDungeon(m_pDungeon);
+		}
+		else if (m_pSlowGenerateCheckBox->IsChecked())
+		{
+			// Slow generation is shown step by step, so it replaces the current dungeon right away
+			m_GenerationThread.Cancel();
+			SetDungeon(pDungeon);
+			m_pDungeon->GenerateDungeon();
+		}
+		else
+		{
+			// Generate the dungeon on the generation thread, this cancels the dungeon that is still being generated
+			m_GenerationThread.Generate(pDungeon);
+		}
 	}
 	else if (callerPtr == m_pSolveDungeonButton.get())  // If the solve dungeon button is pressed
 	{
 		// Start the dungeon solver
 		m_pDungeonSolver->Solve();
 	}
+	else if (callerPtr == m_pSkipStageButton.get())  // If the skip stage button is pressed
+	{
+		// Retrieve the generator from the dungeon
+		DungeonGenerator& generator{ m_pDungeon->GetGenerator() };
+
+		// Generate the rest of the current stage in the next update, the animation continues from the next stage
+		if (!generator.IsDone())
+		{
+			generator.SkipToStage(static_cast<DungeonGenerator::GenerationCycleState>(static_cast<int>(generator.GetGenerationState()) + 1));
+		}
+	}
+}
+
+void DungeonGeneratorMain::SetDungeon(const std::shared_ptr<Dungeon>& pDungeon)
+{
+	m_pDungeon = pDungeon;
+
+	// The cached layer shows the previous dungeon
+	m_IsDungeonLayerValid = false;
+
+	// The solver of the previous dungeon can't solve this dungeon
+	m_pDungeonSolver = std::make_unique<SlowDungeonSolver>(m_pDungeon);
 }
 
 void DungeonGeneratorMain::CreateUI(const DungeonGenerator& generator)
@@ -307,9 +442,104 @@ void DungeonGeneratorMain::CreateUI(const DungeonGenerator& generator)
 	m_pNeedAllKeysCheckbox->SetBounds(GAME_ENGINE->GetWidth() - 50, GAME_ENGINE->GetHeight() - 280, 30);
 	m_pNeedAllKeysCheckbox->Show();
 
+	// Longest path checkbox
+	m_pLongestPathCheckbox = std::make_unique<CheckBox>();
+	m_pLongestPathCheckbox->SetBounds(GAME_ENGINE->GetWidth() - 50, GAME_ENGINE->GetHeight() - 320, 30);
+	m_pLongestPathCheckbox->Show();
+
+	// Minimum translation seperation checkbox
+	m_pMinimumTranslationCheckbox = std::make_unique<CheckBox>();
+	m_pMinimumTranslationCheckbox->SetBounds(GAME_ENGINE->GetWidth() - 50, GAME_ENGINE->GetHeight() - 360, 30);
+	m_pMinimumTranslationCheckbox->Show();
+
+	// Step time budget textbox
+	m_pStepTimeBudgetTextBox = std::make_unique<TextBox>();
+	m_pStepTimeBudgetTextBox->SetBounds(GAME_ENGINE->GetWidth() - 90, GAME_ENGINE->GetHeight() - 400, 70, 30);
+	m_pStepTimeBudgetTextBox->Show();
+
+	tstringstream stepTimeBudgetStream{};
+	stepTimeBudgetStream << generator.GetStepTimeBudget();
+	m_pStepTimeBudgetTextBox->SetText(stepTimeBudgetStream.str());
+
 	// Solve dungeon button
 	m_pSolveDungeonButton = std::make_unique<Button>(_T("Solve Dungeon"));
 	m_pSolveDungeonButton->SetBounds(GAME_ENGINE->GetWidth() - 220, 20, 200, 30);
 	m_pSolveDungeonButton->Show();
 	m_pSolveDungeonButton->AddActionListener(this);
+
+	// Skip stage button
+	m_pSkipStageButton = std::make_unique<Button>(_T("Skip Stage"));
+	m_pSkipStageButton->SetBounds(GAME_ENGINE->GetWidth() - 220, 60, 200, 30);
+	m_pSkipStageButton->Show();
+	m_pSkipStageButton->AddActionListener(this);
+
+#ifdef DUNGEON_PROFILING
+	// Profiler overlay checkbox
+	m_pProfilerCheckBox = std::make_unique<CheckBox>();
+	m_pProfilerCheckBox->SetBounds(GAME_ENGINE->GetWidth() - 50, GAME_ENGINE->GetHeight() - 440, 30);
+	m_pProfilerCheckBox->Show();
+#endif
+}
+
+#ifdef DUNGEON_PROFILING
+void DungeonGeneratorMain::DrawProfiler() const
+{
+	// The size of the overlay
+	constexpr int margin{ 10 };
+	constexpr int lineHeight{ 18 };
+	constexpr int width{ 300 };
+
+	std::vector<tstring> lines{};
+	tstringstream line{};
+	line << std::fixed << std::setprecision(2);
+
+	// Adds the text of the line stream as a line and empties the stream
+	const auto addLine{ [&]()
+	{
+		lines.push_back(line.str());
+		line.str(tstring{});
+	} };
+
+	// The time of the last frame and the part of it that Tick and Paint took
+	line << _T("Frame: ") << m_FrameSeconds * 1000.0f << _T(" ms");
+	addLine();
+	line << _T("  Tick: ") << Profiler::GetTime(Profiler::Timer::Tick) * 1000.0 << _T(" ms, Paint: ") << Profiler::GetTime(Profiler::Timer::Paint) * 1000.0 << _T(" ms");
+	addLine();
+	line << _T("  Heap allocations: ") << m_NrFrameAllocations;
+	addLine();
+
+	// The time every stage of the shown dungeon took
+	const DungeonGenerator::GenerationStatistics& statistics{ m_pDungeon->GetGenerator().GetStatistics() };
+	line << _T("Last generation:");
+	addLine();
+	for (int stage{}; stage < static_cast<int>(DungeonGenerator::GenerationCycleState::DONE); ++stage)
+	{
+		line << _T("  ") << DungeonGenerator::GetStageName(static_cast<DungeonGenerator::GenerationCycleState>(stage)) << _T(": ") << statistics.stageSeconds[stage] * 1000.0 << _T(" ms");
+		addLine();
+	}
+	line << _T("  KEY_PLACEMENT: ") << m_pDungeon->GetKeyPlacementTime() * 1000.0 << _T(" ms");
+	addLine();
+	line << _T("  Seperation passes: ") << statistics.nrSeperationIterations << _T(", retries: ") << statistics.nrRetries << _T(", blocked corridors: ") << statistics.nrBlockedCorridors;
+	addLine();
+
+	// Everything that was counted since the regenerate button was pressed
+	const Profiler::Snapshot profile{ Profiler::TakeSnapshot() };
+	line << _T("Since regenerating:");
+	addLine();
+	for (int counterIdx{}; counterIdx < static_cast<int>(Profiler::Counter::Count); ++counterIdx)
+	{
+		line << _T("  ") << Profiler::GetCounterName(static_cast<Profiler::Counter>(counterIdx)) << _T(": ") << profile.counts[counterIdx] - m_GenerationProfile.counts[counterIdx];
+		addLine();
+	}
+
+	// Draw the lines on a dark background, so they can be read on top of the dungeon
+	GAME_ENGINE->SetColor(RGB(0, 0, 0));
+	GAME_ENGINE->FillRect(margin, margin, width, static_cast<int>(lines.size()) * lineHeight + margin, 180);
+
+	GAME_ENGINE->SetColor(RGB(255, 255, 255));
+	for (size_t lineIdx{}; lineIdx < lines.size(); ++lineIdx)
+	{
+		GAME_ENGINE->DrawString(lines[lineIdx], margin * 3 / 2, margin * 3 / 2 + static_cast<int>(lineIdx) * lineHeight);
+	}
 }
+#endif
@@ -13,6 +13,8 @@
 #include "AbstractGame.h"
 #include "Dungeon.h"
 #include "SlowDungeonSolver.h"
+#include "DungeonGenerationThread.h"
+#include "Profiler.h"
 
 //-----------------------------------------------------------------
 // DungeonGeneratorMain Class																
@@ -56,11 +58,17 @@ private:
 	// Private member functions								
 	//-------------------------------------------------
 	void CreateUI(const DungeonGenerator& generator);
+	void SetDungeon(const std::shared_ptr<Dungeon>& pDungeon);
+#ifdef DUNGEON_PROFILING
+	void DrawProfiler() const;
+#endif
 
 	// -------------------------
 	// Datamembers
 	// -------------------------
 	std::shared_ptr<Dungeon> m_pDungeon{};
+	// Generates the next dungeon when slow generation is disabled, the current dungeon is drawn until it is done
+	DungeonGenerationThread m_GenerationThread{};
 	std::unique_ptr<CheckBox> m_pSlowGenerateCheckBox{};
 	std::unique_ptr<Button> m_pRegenerateButton{};
 	std::unique_ptr<TextBox> m_pSeedTextBox{};
@@ -68,6 +76,10 @@ private:
 	std::unique_ptr<TextBox> m_pInitRoomCountTextBox{};
 	std::unique_ptr<TextBox> m_pNrKeysTextBox{};
 	std::unique_ptr<CheckBox> m_pNeedAllKeysCheckbox{};
+	std::unique_ptr<CheckBox> m_pLongestPathCheckbox{};
+	std::unique_ptr<CheckBox> m_pMinimumTranslationCheckbox{};
+	std::unique_ptr<TextBox> m_pStepTimeBudgetTextBox{};
+	std::unique_ptr<Button> m_pSkipStageButton{};
 
 	tstring m_ErrorMessage{};
 
@@ -75,4 +87,19 @@ private:
 	std::unique_ptr<Button> m_pSolveDungeonButton{};
 
 	Vector2 m_PrevMousePos{};
+
+	// A finished dungeon is drawn once to the cached layer of the engine, and only drawn again when it or the camera changes
+	bool m_IsDungeonLayerValid{};
+	int m_DungeonLayerVersion{};
+	int m_CameraLayerVersion{};
+
+#ifdef DUNGEON_PROFILING
+	// Shows how long the frames take and what the last generation did
+	std::unique_ptr<CheckBox> m_pProfilerCheckBox{};
+	float m_FrameSeconds{};
+	long long m_NrFrameAllocations{};
+	Profiler::Snapshot m_PrevFrameProfile{};
+	// The counters when the current dungeon started generating, the overlay shows everything counted since then
+	Profiler::Snapshot m_GenerationProfile{};
+#endif
 };
@@ -0,0 +1,205 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "DungeonLibrary.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//---------------------------
+// Constructor & Destructor
+//---------------------------
+DungeonLibrary::~DungeonLibrary()
+{
+	Close();
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+bool DungeonLibrary::Open(const std::string& path)
+{
+	Close();
+
+	if (!Map(path)) return false;
+
+	// Check the header, a library of another version is not read
+	const DungeonLibraryHeader* pHeader{ reinterpret_cast<const DungeonLibraryHeader*>(m_pData) };
+	const bool isValidHeader
+	{
+		m_Size >= sizeof(DungeonLibraryHeader) &&
+		pHeader->magic == g_DungeonLibraryMagic &&
+		pHeader->version == g_DungeonLibraryVersion &&
+		pHeader->indexOffset % alignof(DungeonLibraryEntry) == 0 &&
+		pHeader->indexOffset <= m_Size &&
+		pHeader->nrDungeons <= (m_Size - pHeader->indexOffset) / sizeof(DungeonLibraryEntry)
+	};
+	if (!isValidHeader)
+	{
+		Close();
+		return false;
+	}
+
+	// The index is used in place, dungeons are only read when they are requested
+	m_pEntries = reinterpret_cast<const DungeonLibraryEntry*>(m_pData + pHeader->indexOffset);
+	m_NrDungeons = static_cast<int>(pHeader->nrDungeons);
+
+	return true;
+}
+
+void DungeonLibrary::Close()
+{
+	Unmap();
+
+	m_pEntries = nullptr;
+	m_NrDungeons = 0;
+}
+
+bool DungeonLibrary::GetDungeon(int idx, DungeonView& view) const
+{
+	if (idx < 0 || idx >= m_NrDungeons) return false;
+
+	const DungeonLibraryEntry& entry{ m_pEntries[idx] };
+
+	// The record header has to fit in the file
+	if (entry.offset % alignof(DungeonRecordHeader) != 0 || entry.offset > m_Size || entry.size > m_Size - entry.offset) return false;
+	if (entry.size < sizeof(DungeonRecordHeader)) return false;
+
+	const unsigned char* pRecord{ m_pData + entry.offset };
+	const DungeonRecordHeader* pHeader{ reinterpret_cast<const DungeonRecordHeader*>(pRecord) };
+	if (pHeader->nrRooms < 0 || pHeader->nrConnections < 0 || pHeader->nrEdges < 0) return false;
+
+	// The arrays have to fill the rest of the record exactly
+	const uint64_t roomsSize{ static_cast<uint64_t>(pHeader->nrRooms) * sizeof(DungeonRoomRecord) };
+	const uint64_t offsetsSize{ (static_cast<uint64_t>(pHeader->nrRooms) + 1) * sizeof(int32_t) };
+	const uint64_t connectionsSize{ static_cast<uint64_t>(pHeader->nrConnections) * sizeof(int32_t) };
+	const uint64_t edgesSize{ static_cast<uint64_t>(pHeader->nrEdges) * sizeof(DungeonEdgeRecord) };
+	if (sizeof(DungeonRecordHeader) + roomsSize + offsetsSize + connectionsSize + edgesSize != entry.size) return false;
+
+	const int32_t* pConnectionOffsets{ reinterpret_cast<const int32_t*>(pRecord + sizeof(DungeonRecordHeader) + roomsSize) };
+	const int32_t* pConnections{ pConnectionOffsets + pHeader->nrRooms + 1 };
+	const DungeonEdgeRecord* pEdges{ reinterpret_cast<const DungeonEdgeRecord*>(pConnections + pHeader->nrConnections) };
+
+	// Every index in the record is used without checking it again, so a record that points outside of its arrays is not read
+	const int32_t nrRooms{ pHeader->nrRooms };
+	const auto isRoomIdx{ [nrRooms](int32_t roomIdx) { return roomIdx >= 0 && roomIdx < nrRooms; } };
+	if ((pHeader->startRoom != -1 && !isRoomIdx(pHeader->startRoom)) || (pHeader->endRoom != -1 && !isRoomIdx(pHeader->endRoom))) return false;
+
+	// The connection offsets start at 0, never go down and end at the amount of connections
+	if (pConnectionOffsets[0] != 0 || pConnectionOffsets[nrRooms] != pHeader->nrConnections) return false;
+	for (int32_t roomIdx{}; roomIdx < nrRooms; ++roomIdx)
+	{
+		if (pConnectionOffsets[roomIdx] > pConnectionOffsets[roomIdx + 1]) return false;
+	}
+
+	for (int32_t connectionIdx{}; connectionIdx < pHeader->nrConnections; ++connectionIdx)
+	{
+		if (!isRoomIdx(pConnections[connectionIdx])) return false;
+	}
+
+	for (int32_t edgeIdx{}; edgeIdx < pHeader->nrEdges; ++edgeIdx)
+	{
+		if (!isRoomIdx(pEdges[edgeIdx].room0) || !isRoomIdx(pEdges[edgeIdx].room1)) return false;
+	}
+
+	view.pHeader = pHeader;
+	view.pRooms = reinterpret_cast<const DungeonRoomRecord*>(pRecord + sizeof(DungeonRecordHeader));
+	view.pConnectionOffsets = pConnectionOffsets;
+	view.pConnections = pConnections;
+	view.pEdges = pEdges;
+
+	return true;
+}
+
+bool DungeonLibrary::FindDungeon(int seed, DungeonView& view) const
+{
+	// The index is sorted by seed
+	const DungeonLibraryEntry* pEnd{ m_pEntries + m_NrDungeons };
+	const DungeonLibraryEntry* pEntry{ std::lower_bound(m_pEntries, pEnd, seed,
+		[](const DungeonLibraryEntry& entry, int seed) { return entry.seed < seed; }) };
+
+	if (pEntry == pEnd || pEntry->seed != seed) return false;
+
+	return GetDungeon(static_cast<int>(pEntry - m_pEntries), view);
+}
+
+bool DungeonLibrary::Map(const std::string& path)
+{
+#ifdef _WIN32
+	m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_File == INVALID_HANDLE_VALUE)
+	{
+		m_File = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Unmap();
+		return false;
+	}
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_Mapping)
+	{
+		Unmap();
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	m_File = open(path.c_str(), O_RDONLY);
+	if (m_File < 0) return false;
+
+	struct stat fileStatus{};
+	if (fstat(m_File, &fileStatus) != 0 || fileStatus.st_size == 0)
+	{
+		Unmap();
+		return false;
+	}
+	m_Size = static_cast<size_t>(fileStatus.st_size);
+
+	void* pData{ mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, m_File, 0) };
+	m_pData = pData == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(pData);
+#endif
+
+	if (!m_pData)
+	{
+		Unmap();
+		return false;
+	}
+	return true;
+}
+
+void DungeonLibrary::Unmap()
+{
+#ifdef _WIN32
+	if (m_pData) UnmapViewOfFile(m_pData);
+	if (m_Mapping) CloseHandle(m_Mapping);
+	if (m_File) CloseHandle(m_File);
+	m_Mapping = nullptr;
+	m_File = nullptr;
+#else
+	if (m_pData) munmap(const_cast<unsigned char*>(m_pData), m_Size);
+	if (m_File >= 0) close(m_File);
+	m_File = -1;
+#endif
+
+	m_pData = nullptr;
+	m_Size = 0;
+}
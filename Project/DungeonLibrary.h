@@ -0,0 +1,142 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+//-----------------------------------------------------
+// Dungeon Library Format
+//-----------------------------------------------------
+// A library file starts with a header, followed by the record of every dungeon and an index with one entry per dungeon sorted by seed
+// Every value is a little endian 32 or 64 bit integer and every record starts at a multiple of 4 bytes, so the file can be used in place
+constexpr uint32_t g_DungeonLibraryMagic{ 0x4C4E4744 }; // "DGNL"
+constexpr uint32_t g_DungeonLibraryVersion{ 1 };
+
+struct DungeonLibraryHeader
+{
+	uint32_t magic{};
+	uint32_t version{};
+	uint32_t nrDungeons{};
+	uint32_t reserved{};
+	uint64_t indexOffset{};
+};
+
+struct DungeonLibraryEntry
+{
+	int32_t seed{};
+	uint32_t size{};
+	uint64_t offset{};
+};
+
+// A dungeon record is this header followed by its rooms, the connection offsets of every room and one more,
+// the connections and the edges of the minimum spanning tree
+struct DungeonRecordHeader
+{
+	int32_t seed{};
+	int32_t nrRooms{};
+	int32_t nrConnections{};
+	int32_t nrEdges{};
+	int32_t startRoom{};
+	int32_t endRoom{};
+
+	// The parameters the dungeon was generated with
+	int32_t initRadius{};
+	int32_t initRoomCount{};
+	int32_t minRoomSize{};
+	int32_t maxRoomSize{};
+	int32_t roomSizeThreshold{};
+	int32_t nrKeys{};
+	int32_t needAllKeys{};
+	int32_t isUsingLongestPath{};
+	int32_t seperationMode{};
+	int32_t reserved{};
+};
+
+struct DungeonRoomRecord
+{
+	int32_t x{};
+	int32_t y{};
+	int32_t width{};
+	int32_t height{};
+	int32_t type{};
+};
+
+struct DungeonEdgeRecord
+{
+	int32_t room0{};
+	int32_t room1{};
+};
+
+// One dungeon of an open library, every pointer points into the library and stays valid until the library is closed
+// The neighbours of room i are pConnections[pConnectionOffsets[i]] up to pConnections[pConnectionOffsets[i + 1]]
+struct DungeonView
+{
+	const DungeonRecordHeader* pHeader{};
+	const DungeonRoomRecord* pRooms{};
+	const int32_t* pConnectionOffsets{};
+	const int32_t* pConnections{};
+	const DungeonEdgeRecord* pEdges{};
+};
+
+//-----------------------------------------------------
+// DungeonLibrary Class
+//-----------------------------------------------------
+// Reads pre-generated dungeons from a library file, without the generator
+// The file is mapped into memory, so opening it only reads the header and nothing is copied or allocated per dungeon
+class DungeonLibrary final
+{
+public:
+	DungeonLibrary() = default;	// Constructor
+	~DungeonLibrary();			// Destructor
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	DungeonLibrary(const DungeonLibrary& other) = delete;
+	DungeonLibrary(DungeonLibrary&& other) noexcept = delete;
+	DungeonLibrary& operator=(const DungeonLibrary& other) = delete;
+	DungeonLibrary& operator=(DungeonLibrary&& other) noexcept = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	// Returns false if the file can't be mapped or is not a library of this version
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return m_pData != nullptr; }
+	int GetCount() const { return m_NrDungeons; }
+
+	// Returns false if the index is out of range, the record doesn't fit in the file or it contains a room index outside of the dungeon
+	// Every index of a returned view can be used without checking it
+	bool GetDungeon(int idx, DungeonView& view) const;
+	// Searches the dungeon with this seed in the index, returns false if the library doesn't contain it
+	bool FindDungeon(int seed, DungeonView& view) const;
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	bool Map(const std::string& path);
+	void Unmap();
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	const unsigned char* m_pData{};
+	size_t m_Size{};
+
+	const DungeonLibraryEntry* m_pEntries{};
+	int m_NrDungeons{};
+
+	// The handles of the mapped file
+#ifdef _WIN32
+	void* m_File{};
+	void* m_Mapping{};
+#else
+	int m_File{ -1 };
+#endif
+};
@@ -0,0 +1,117 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "DungeonLibraryWriter.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+//---------------------------
+// Constructor & Destructor
+//---------------------------
+DungeonLibraryWriter::DungeonLibraryWriter()
+{
+	Clear();
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void DungeonLibraryWriter::Add(int seed, const DungeonParameters& parameters, const Dungeon& dungeon)
+{
+	const std::vector<DungeonRoom>& rooms{ dungeon.GetRooms() };
+	const AdjacencyList& connections{ dungeon.GetConnections() };
+	const std::vector<Edge>& minimumSpanningTree{ dungeon.GetGenerator().GetMinimumSpanningTree() };
+
+	DungeonRecordHeader header{};
+	header.seed = seed;
+	header.nrRooms = static_cast<int32_t>(rooms.size());
+	header.nrConnections = static_cast<int32_t>(connections.neighbours.size());
+	header.nrEdges = static_cast<int32_t>(minimumSpanningTree.size());
+	header.startRoom = dungeon.GetStartRoom();
+	header.endRoom = dungeon.GetEndRoom();
+	header.initRadius = parameters.initRadius;
+	header.initRoomCount = parameters.initRoomCount;
+	header.minRoomSize = parameters.roomSizeBounds.x;
+	header.maxRoomSize = parameters.roomSizeBounds.y;
+	header.roomSizeThreshold = parameters.roomSizeThreshold;
+	header.nrKeys = parameters.nrKeys;
+	header.needAllKeys = parameters.needAllKeys ? 1 : 0;
+	header.isUsingLongestPath = parameters.isUsingLongestPath ? 1 : 0;
+	header.seperationMode = static_cast<int32_t>(parameters.seperationMode);
+
+	m_Rooms.clear();
+	for (const DungeonRoom& room : rooms)
+	{
+		m_Rooms.push_back(DungeonRoomRecord{ room.GetPosition().x, room.GetPosition().y, room.GetSize().x, room.GetSize().y, static_cast<int32_t>(room.GetRoomType()) });
+	}
+
+	m_Edges.clear();
+	for (const Edge& edge : minimumSpanningTree)
+	{
+		m_Edges.push_back(DungeonEdgeRecord{ edge.p0.second, edge.p1.second });
+	}
+
+	// A dungeon without rooms has no connection offsets, the record still needs the offset after the last room
+	const int32_t emptyOffset{};
+	const bool hasOffsets{ connections.offsets.size() == rooms.size() + 1 };
+
+	const size_t recordStart{ m_Buffer.size() };
+	Append(&header, 1);
+	Append(m_Rooms.data(), m_Rooms.size());
+	if (hasOffsets) Append(connections.offsets.data(), connections.offsets.size());
+	else Append(&emptyOffset, 1);
+	Append(connections.neighbours.data(), connections.neighbours.size());
+	Append(m_Edges.data(), m_Edges.size());
+
+	m_Entries.push_back(DungeonLibraryEntry{ seed, static_cast<uint32_t>(m_Buffer.size() - recordStart), static_cast<uint64_t>(recordStart) });
+}
+
+bool DungeonLibraryWriter::Write(const std::string& path)
+{
+	// The index is sorted by seed, so a dungeon can be found without reading every entry
+	std::stable_sort(m_Entries.begin(), m_Entries.end(), [](const DungeonLibraryEntry& entry0, const DungeonLibraryEntry& entry1)
+		{
+			return entry0.seed < entry1.seed;
+		});
+
+	// The index starts at a multiple of its alignment
+	const size_t recordsSize{ m_Buffer.size() };
+	m_Buffer.resize((recordsSize + alignof(DungeonLibraryEntry) - 1) / alignof(DungeonLibraryEntry) * alignof(DungeonLibraryEntry), 0);
+
+	DungeonLibraryHeader header{};
+	header.magic = g_DungeonLibraryMagic;
+	header.version = g_DungeonLibraryVersion;
+	header.nrDungeons = static_cast<uint32_t>(m_Entries.size());
+	header.indexOffset = static_cast<uint64_t>(m_Buffer.size());
+	std::memcpy(m_Buffer.data(), &header, sizeof(header));
+
+	// Add the index behind the records and write everything at once
+	Append(m_Entries.data(), m_Entries.size());
+
+	std::ofstream file{ path, std::ios::binary };
+	file.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+	file.close();
+
+	// Remove the index again, more dungeons can still be added
+	m_Buffer.resize(recordsSize);
+
+	return !file.fail();
+}
+
+void DungeonLibraryWriter::Clear()
+{
+	// The header is filled in when the library is written
+	m_Buffer.assign(sizeof(DungeonLibraryHeader), 0);
+	m_Entries.clear();
+}
+
+template<typename T>
+void DungeonLibraryWriter::Append(const T* pValues, size_t count)
+{
+	if (count == 0) return;
+
+	const size_t size{ m_Buffer.size() };
+	m_Buffer.resize(size + count * sizeof(T));
+	std::memcpy(m_Buffer.data() + size, pValues, count * sizeof(T));
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include "DungeonLibrary.h"
+#include "DungeonBatchGenerator.h"
+#include <vector>
+#include <string>
+
+//-----------------------------------------------------
+// DungeonLibraryWriter Class
+//-----------------------------------------------------
+// Collects finished dungeons in the library format, the whole library is written to the file at once
+class DungeonLibraryWriter final
+{
+public:
+	DungeonLibraryWriter();				// Constructor
+	~DungeonLibraryWriter() = default;	// Destructor
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	// Copies the finished dungeon into the library, the dungeon can be reused after this
+	void Add(int seed, const DungeonParameters& parameters, const Dungeon& dungeon);
+	// Returns false if the file couldn't be written
+	bool Write(const std::string& path);
+	void Clear();
+
+	int GetCount() const { return static_cast<int>(m_Entries.size()); }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	template<typename T>
+	void Append(const T* pValues, size_t count);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	// The whole file, the header is filled in and the index is added right before it is written
+	std::vector<unsigned char> m_Buffer{};
+	std::vector<DungeonLibraryEntry> m_Entries{};
+
+	// Scratch data of the dungeon that is being added
+	std::vector<DungeonRoomRecord> m_Rooms{};
+	std::vector<DungeonEdgeRecord> m_Edges{};
+};
@@ -2,9 +2,11 @@
 // Includes
 //---------------------------
 #include "DungeonRoom.h"
+#ifndef DUNGEON_HEADLESS
 #include "GameEngine.h"
 #include "GameDefines.h"
 #include "Camera.h"
+#endif
 
 //---------------------------
 // Constructor & Destructor
@@ -34,31 +36,110 @@ void DungeonRoom::SetRoomType(DungeonRoomType type)
 	m_RoomType = type;
 }
 
-void DungeonRoom::AddConnection(int roomIdx)
+#ifndef DUNGEON_HEADLESS
+void DungeonRoom::Draw(bool debugRender) const
+{
+	GAME_ENGINE->SetColor(GetDrawColor(debugRender));
+	
+	// Draw the room
+	const Vector2 scaledPosition{ CAMERA->ScalePoint(m_Position) };
+	const int scaledSizeX{ CAMERA->ScaleSize(m_Size.x) };
+	const int scaledSizeY{ CAMERA->ScaleSize(m_Size.y) };
+	GAME_ENGINE->DrawRect(scaledPosition.x, scaledPosition.y, scaledSizeX, scaledSizeY);
+
+	if (debugRender) return;
+
+	DrawDecoration();
+}
+
+void DungeonRoom::DrawRooms(const std::vector<DungeonRoom>& rooms, bool debugRender)
 {
-	m_ConnectedRooms.push_back(roomIdx);
+	DrawRooms(rooms, nullptr, static_cast<int>(rooms.size()), debugRender);
 }
 
-void DungeonRoom::Draw(bool debugRender) const
+void DungeonRoom::DrawRooms(const std::vector<DungeonRoom>& rooms, const std::vector<int>& roomIndices, bool debugRender)
+{
+	DrawRooms(rooms, roomIndices.data(), static_cast<int>(roomIndices.size()), debugRender);
+}
+
+void DungeonRoom::DrawRooms(const std::vector<DungeonRoom>& rooms, const int* pRoomIndices, int nrRooms, bool debugRender)
 {
-	if (debugRender)
+	// Rooms that are smaller than this amount of pixels are drawn as one dot per dot sized part of the screen
+	constexpr int minRoomPixels{ 3 };
+
+	const int nrCellsX{ GAME_ENGINE->GetWidth() / minRoomPixels + 1 };
+	const int nrCellsY{ GAME_ENGINE->GetHeight() / minRoomPixels + 1 };
+	std::vector<bool> isCellTaken{};
+
+	std::vector<RECT> outlines{};
+	std::vector<const DungeonRoom*> decoratedRooms{};
+
+	// Draw the outlines one color at a time, rooms and corridors are stored after each other so this is only a few calls
+	COLORREF curColor{};
+	for (int i{}; i < nrRooms; ++i)
 	{
-		// Render in gray
-		GAME_ENGINE->SetColor(RGB(127, 127, 127));
+		const DungeonRoom& room{ rooms[pRoomIndices ? pRoomIndices[i] : i] };
+
+		// Skip rooms that are not on screen
+		const Vector2 scaledPosition{ CAMERA->ScalePoint(room.m_Position) };
+		const Vector2 scaledSize{ CAMERA->ScaleSize(room.m_Size.x), CAMERA->ScaleSize(room.m_Size.y) };
+		if (!CAMERA->IsOnScreen(scaledPosition, scaledSize)) continue;
+
+		RECT outline{ scaledPosition.x, scaledPosition.y, scaledPosition.x + scaledSize.x, scaledPosition.y + scaledSize.y };
+		if (scaledSize.x < minRoomPixels && scaledSize.y < minRoomPixels)
+		{
+			// Only the first small room in a part of the screen is drawn, the others would cover the same pixels
+			if (isCellTaken.empty()) isCellTaken.resize(nrCellsX * nrCellsY);
+
+			const int cellX{ min(max(scaledPosition.x, 0) / minRoomPixels, nrCellsX - 1) };
+			const int cellY{ min(max(scaledPosition.y, 0) / minRoomPixels, nrCellsY - 1) };
+			if (isCellTaken[cellX + cellY * nrCellsX]) continue;
+			isCellTaken[cellX + cellY * nrCellsX] = true;
+
+			outline = RECT{ cellX * minRoomPixels, cellY * minRoomPixels, (cellX + 1) * minRoomPixels, (cellY + 1) * minRoomPixels };
+		}
+		else if (!debugRender && (room.m_RoomType == DungeonRoomType::KeyRoom || room.m_RoomType == DungeonRoomType::LockedRoom))
+		{
+			decoratedRooms.push_back(&room);
+		}
+
+		const COLORREF color{ room.GetDrawColor(debugRender) };
+		if (!outlines.empty() && color != curColor)
+		{
+			GAME_ENGINE->DrawRects(outlines.data(), static_cast<int>(outlines.size()));
+			outlines.clear();
+		}
+		if (outlines.empty())
+		{
+			curColor = color;
+			GAME_ENGINE->SetColor(curColor);
+		}
+
+		outlines.push_back(outline);
 	}
-	else
+	if (!outlines.empty()) GAME_ENGINE->DrawRects(outlines.data(), static_cast<int>(outlines.size()));
+
+	// Draw the keys and locked rooms on top of the outlines
+	for (const DungeonRoom* pRoom : decoratedRooms)
 	{
-		// Render in room color
-		GAME_ENGINE->SetColor(m_Color.GetColor());
+		pRoom->DrawDecoration();
 	}
-	
-	// Draw the room
+}
+
+COLORREF DungeonRoom::GetDrawColor(bool debugRender) const
+{
+	// Render in gray
+	if (debugRender) return RGB(127, 127, 127);
+
+	// Render in room color
+	return m_Color.GetColor();
+}
+
+void DungeonRoom::DrawDecoration() const
+{
 	const Vector2 scaledPosition{ CAMERA->ScalePoint(m_Position) };
 	const int scaledSizeX{ CAMERA->ScaleSize(m_Size.x) };
 	const int scaledSizeY{ CAMERA->ScaleSize(m_Size.y) };
-	GAME_ENGINE->DrawRect(scaledPosition.x, scaledPosition.y, scaledSizeX, scaledSizeY);
-
-	if (debugRender) return;
 
 	switch (m_RoomType)
 	{
@@ -88,6 +169,7 @@ void DungeonRoom::Draw(bool debugRender) const
 	}
 	}
 }
+#endif
 
 bool DungeonRoom::IsOverlapping(const DungeonRoom& other) const
 {
@@ -95,6 +177,12 @@ bool DungeonRoom::IsOverlapping(const DungeonRoom& other) const
 		m_Position.y + m_Size.y > other.m_Position.y && m_Position.y < other.m_Position.y + other.m_Size.y;
 }
 
+bool DungeonRoom::IsTouching(const DungeonRoom& other) const
+{
+	return m_Position.x <= other.m_Position.x + other.m_Size.x && m_Position.x + m_Size.x >= other.m_Position.x &&
+		m_Position.y + m_Size.y >= other.m_Position.y && m_Position.y <= other.m_Position.y + other.m_Size.y;
+}
+
 Vector2 DungeonRoom::GetPosition() const
 {
 	return m_Position;
@@ -110,11 +198,6 @@ DungeonRoom::DungeonRoomType DungeonRoom::GetRoomType() const
 	return m_RoomType;
 }
 
-const std::vector<int>& DungeonRoom::GetConnections() const
-{
-	return m_ConnectedRooms;
-}
-
 bool DungeonRoom::HasKey() const
 {
 	return m_RoomType == DungeonRoomType::KeyRoom;
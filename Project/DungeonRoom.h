@@ -4,6 +4,7 @@
 // Include Files
 //-----------------------------------------------------
 #include "DataTypes.h"
+#include <vector>
 
 //-----------------------------------------------------
 // DungeonRoom Class									
@@ -30,24 +31,39 @@ public:
 	void Move(const Vector2& direction);
 	void SetColor(const Color& color);
 	void SetRoomType(DungeonRoomType type);
-	void AddConnection(int roomIdx);
 
+#ifndef DUNGEON_HEADLESS
 	void Draw(bool debugRender = false) const;
+
+	// Draws the outlines of rooms with the same color after each other in one call
+	// Rooms that are off screen are skipped and rooms that are only a few pixels big are merged
+	static void DrawRooms(const std::vector<DungeonRoom>& rooms, bool debugRender = false);
+	static void DrawRooms(const std::vector<DungeonRoom>& rooms, const std::vector<int>& roomIndices, bool debugRender = false);
+#endif
 	bool IsOverlapping(const DungeonRoom& other) const;
+	// Rooms that only share a side also touch each other
+	bool IsTouching(const DungeonRoom& other) const;
 	Vector2 GetPosition() const;
 	Vector2 GetSize() const;
 	DungeonRoomType GetRoomType() const;
-	const std::vector<int>& GetConnections() const;
 	bool HasKey() const;
 	bool IsLocked() const;
 
 private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+#ifndef DUNGEON_HEADLESS
+	static void DrawRooms(const std::vector<DungeonRoom>& rooms, const int* pRoomIndices, int nrRooms, bool debugRender);
+	COLORREF GetDrawColor(bool debugRender) const;
+	void DrawDecoration() const;
+#endif
+
 	//-------------------------------------------------
 	// Datamembers								
 	//-------------------------------------------------
 	Vector2 m_Position{};
 	Vector2 m_Size{};
 	Color m_Color{};
-	std::vector<int> m_ConnectedRooms{};
 	DungeonRoomType m_RoomType{ DungeonRoomType::Room };
 };
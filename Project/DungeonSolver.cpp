@@ -1,7 +1,8 @@
 #include "DungeonSolver.h"
 #include "Dungeon.h"
-
-std::vector<int> DungeonSolver::m_ShortestPath{};
+#include "Profiler.h"
+#include <climits>
+#include <algorithm>
 
 DungeonSolver::DungeonSolver(std::shared_ptr<Dungeon> dungeon)
 	: m_pDungeon { dungeon }
@@ -10,11 +11,10 @@ DungeonSolver::DungeonSolver(std::shared_ptr<Dungeon> dungeon)
 
 bool DungeonSolver::Solve(bool saveShortestRoute)
 {
+	PROFILE_COUNT(SolveCalls, 1);
+
 	// Reset the previous rooms and discovered rooms
-	m_PreviousRooms = std::stack<int>();
-	m_DiscoveredRooms.clear();
-	m_TotalPath.clear();
-	m_NrKeys = 0;
+	ResetSolve();
 
 	// Set the current room to the start room
 	m_CurRoom = m_pDungeon->GetStartRoom();
@@ -22,6 +22,9 @@ bool DungeonSolver::Solve(bool saveShortestRoute)
 	// Get the end room
 	const int endRoom{ m_pDungeon->GetEndRoom() };
 
+	// A dungeon without a start or an end room can't be solved
+	if (m_CurRoom < 0 || endRoom < 0) return false;
+
 	// While the solver has not reached the end room
 	while (m_CurRoom != endRoom)
 	{
@@ -46,51 +49,65 @@ bool DungeonSolver::Solve(bool saveShortestRoute)
 	return hasSolvedDungeon && (!m_NeedAllKeys || m_pDungeon->IsSolved());
 }
 
-bool DungeonSolver::HasDiscovered(int roomIdx) const
+void DungeonSolver::ResetSolve()
 {
-	for (int discoveredRoomIdx : m_DiscoveredRooms)
+	// Clear the containers, this keeps their memory for the next solve
+	m_PreviousRooms.clear();
+	m_TotalPath.clear();
+	m_ForcedPath.clear();
+	m_NrKeys = 0;
+
+	// Make sure every room has a stamp, new stamps are never equal to the current stamp
+	const size_t nrRooms{ m_pDungeon->GetRooms().size() };
+	if (m_DiscoveredStamps.size() < nrRooms) m_DiscoveredStamps.resize(nrRooms, 0);
+
+	// Forget every discovered room by using a new stamp, only clear the stamps when the stamp would overflow
+	if (m_CurStamp == INT_MAX)
 	{
-		if (roomIdx == discoveredRoomIdx) return true;
+		std::fill(m_DiscoveredStamps.begin(), m_DiscoveredStamps.end(), 0);
+		m_CurStamp = 0;
 	}
-	return false;
+	++m_CurStamp;
 }
 
-void DungeonSolver::SaveShortestRoute() const
+bool DungeonSolver::HasDiscovered(int roomIdx) const
 {
-	// Clear any previous path
-	m_ShortestPath.clear();
+	return m_DiscoveredStamps[roomIdx] == m_CurStamp;
+}
+
+void DungeonSolver::SaveShortestRoute()
+{
+	std::vector<int> shortestPath{};
+	std::vector<bool> isOnShortestPath(m_pDungeon->GetRooms().size(), false);
 
 	// For each room in the total path
 	for (int roomIdx : m_TotalPath)
 	{
-		// Check if the current room is already been visited on the shortest path
-		bool alreadyVisited{};
-		for (int visitedIdx : m_ShortestPath)
-		{
-			if (visitedIdx != roomIdx) continue;
-
-			alreadyVisited = true;
-			break;
-		}
-
-		if (!alreadyVisited)
+		if (!isOnShortestPath[roomIdx])
 		{
 			// If this current room is not yet visited on the shorest path, add it to the path
-			m_ShortestPath.push_back(roomIdx);
+			shortestPath.push_back(roomIdx);
+			isOnShortestPath[roomIdx] = true;
 		}
 		else
 		{
 			// If this current room is already been visited, pop the shortest path until it reaches the current room
-			while (*(m_ShortestPath.end() - 1) != roomIdx)
+			while (*(shortestPath.end() - 1) != roomIdx)
 			{
-				m_ShortestPath.pop_back();
+				isOnShortestPath[*(shortestPath.end() - 1)] = false;
+				shortestPath.pop_back();
 			}
 		}
 	}
+
+	// The dungeon owns the shortest path, so every solver of this dungeon uses it
+	m_pDungeon->SetShortestPath({ shortestPath.data(), shortestPath.data() + shortestPath.size() });
 }
 
 bool DungeonSolver::SolveStep()
 {
+	PROFILE_COUNT(SolveSteps, 1);
+
 	// Save the current room in the total path container
 	m_TotalPath.push_back(m_CurRoom);
 
@@ -102,13 +119,13 @@ bool DungeonSolver::SolveStep()
 		m_ForcedPath.pop_back();
 
 		// Save the current room in the previous rooms container
-		m_PreviousRooms.push(m_CurRoom);
+		m_PreviousRooms.push_back(m_CurRoom);
 
 		return true;
 	}
 
-	// If this room has not yet been discovered, add it to the discovered rooms container
-	if (!HasDiscovered(m_CurRoom)) m_DiscoveredRooms.push_back(m_CurRoom);
+	// Mark this room as discovered
+	m_DiscoveredStamps[m_CurRoom] = m_CurStamp;
 	
 	if (m_pDungeon->IsRoomLocked(m_CurRoom)) // If the room is locked
 	{
@@ -116,8 +133,8 @@ bool DungeonSolver::SolveStep()
 		if (m_NrKeys == 0)
 		{
 			// Return to the previous room
-			m_CurRoom = m_PreviousRooms.top();
-			m_PreviousRooms.pop();
+			m_CurRoom = m_PreviousRooms.back();
+			m_PreviousRooms.pop_back();
 
 			return true;
 		}
@@ -131,12 +148,13 @@ bool DungeonSolver::SolveStep()
 		++m_NrKeys;
 
 		// Get the first door on the shortest path
+		const std::vector<int>& shortestPath{ m_pDungeon->GetShortestPath() };
 		int lockedRoomIdx{ -1 };
-		for (int i{}; i < static_cast<int>(m_ShortestPath.size()); ++i)
+		for (int i{}; i < static_cast<int>(shortestPath.size()); ++i)
 		{
-			if (m_pDungeon->IsRoomLocked(m_ShortestPath[i]))
+			if (m_pDungeon->IsRoomLocked(shortestPath[i]))
 			{
-				lockedRoomIdx = m_ShortestPath[i];
+				lockedRoomIdx = shortestPath[i];
 				break;
 			}
 		}
@@ -175,7 +193,7 @@ bool DungeonSolver::SolveStep()
 	}
 
 	// Get all the connections out of this room
-	const std::vector<int>& connections{ m_pDungeon->GetRoomConnectionsFromIndex(m_CurRoom) };
+	const IndexRange connections{ m_pDungeon->GetRoomConnectionsFromIndex(m_CurRoom) };
 
 	// Whether a new room has been found
 	bool foundNewRoom{};
@@ -194,15 +212,7 @@ bool DungeonSolver::SolveStep()
 
 
 		// If the next room is on the shortest path, take this route
-		bool isOnShortestPath{};
-		for (int shortestPathRoomIdx : m_ShortestPath)
-		{
-			if (nextRoom != shortestPathRoomIdx) continue;
-
-			isOnShortestPath = true;
-			break;
-		}
-		if (isOnShortestPath) break;
+		if (m_pDungeon->IsOnShortestPath(nextRoom)) break;
 	}
 
 	// If no connection has not yet been discovered
@@ -212,13 +222,13 @@ bool DungeonSolver::SolveStep()
 		if (m_PreviousRooms.empty()) return false;
 
 		// Return to the previous room
-		m_CurRoom = m_PreviousRooms.top();
-		m_PreviousRooms.pop();
+		m_CurRoom = m_PreviousRooms.back();
+		m_PreviousRooms.pop_back();
 	}
 	else
 	{
 		// Save the current room in the previous rooms container
-		m_PreviousRooms.push(m_CurRoom);
+		m_PreviousRooms.push_back(m_CurRoom);
 
 		// Move to the new room
 		m_CurRoom = nextRoom;
@@ -5,7 +5,6 @@
 //-----------------------------------------------------
 #include <memory>
 #include <vector>
-#include <stack>
 
 //-----------------------------------------------------------------
 // Forward Declarations
@@ -34,18 +33,21 @@ public:
 	//-------------------------------------------------
 	virtual bool Solve(bool saveShortestRoute = false);
 	void SetNeedAllKeys(bool needAllKeys) { m_NeedAllKeys = needAllKeys; }
+	// The amount of rooms the last solve walked through
+	int GetStepCount() const { return static_cast<int>(m_TotalPath.size()); }
 
 private:
 	//-------------------------------------------------
 	// Private member functions								
 	//-------------------------------------------------
 	bool HasDiscovered(int roomIdx) const;
-	void SaveShortestRoute() const;
+	void SaveShortestRoute();
 	
 protected:
 	//-------------------------------------------------
 	// Protected member functions								
 	//-------------------------------------------------
+	void ResetSolve();
 	bool SolveStep();
 
 	//-------------------------------------------------
@@ -55,10 +57,12 @@ protected:
 
 	bool m_NeedAllKeys{};
 	std::vector<int> m_ForcedPath{};
-	static std::vector<int> m_ShortestPath;
 	std::vector<int> m_TotalPath{};
-	std::stack<int> m_PreviousRooms{};
-	std::vector<int> m_DiscoveredRooms{};
+	std::vector<int> m_PreviousRooms{};
+
+	// A room is discovered when its stamp equals the current stamp, a new solve only increments the current stamp
+	std::vector<int> m_DiscoveredStamps{};
+	int m_CurStamp{};
 	int m_CurRoom{};
 	int m_NrKeys{};
 };
@@ -80,6 +80,18 @@ GameEngine::~GameEngine()
 		m_FontDraw = 0;
 	}
 
+	// clean up the cached pens and brushes, they are never selected outside of a draw method
+	for (int i = 0; i < m_PenCache.nrObjects; ++i) DeleteObject(m_PenCache.objects[i]);
+	for (int i = 0; i < m_BrushCache.nrObjects; ++i) DeleteObject(m_BrushCache.objects[i]);
+
+	// clean up the cached layer
+	if (m_HdcLayer != 0)
+	{
+		SelectObject(m_HdcLayer, m_HOldBmpLayer);
+		DeleteObject(m_HBmpLayer);
+		DeleteDC(m_HdcLayer);
+	}
+
 	// delete the game object
 	delete m_GamePtr;
 }
@@ -566,13 +578,11 @@ SIZE GameEngine::CalculateTextDimensions(const tstring& text, Font* fontPtr, REC
 
 bool GameEngine::DrawLine(int x1, int y1, int x2, int y2, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	MoveToEx(hDC, x1, m_Height - y1, nullptr);
 	LineTo(hDC, x2, m_Height - y2);
 	MoveToEx(hDC, 0, m_Height, nullptr); // reset the position - sees to it that eg. AngleArc draws from 0,0 instead of the last position of DrawLine
 	SelectObject(hDC, hOldPen);
-	DeleteObject(hNewPen);
 	
 	return true;
 }
@@ -583,15 +593,39 @@ bool GameEngine::DrawLine(int x1, int y1, int x2, int y2) const
 	else return false;
 }
 
+bool GameEngine::DrawLines(const POINT ptsArr[], int nrLines, HDC hDC) const
+{
+	if (nrLines <= 0) return true;
+
+	// flip every point to window coordinates, every line is a polyline of 2 points
+	m_BatchPoints.resize(nrLines * 2);
+	for (int i = 0; i < nrLines * 2; ++i)
+	{
+		m_BatchPoints[i].x = ptsArr[i].x;
+		m_BatchPoints[i].y = m_Height - ptsArr[i].y;
+	}
+	m_BatchCounts.assign(nrLines, 2);
+
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
+	PolyPolyline(hDC, m_BatchPoints.data(), m_BatchCounts.data(), nrLines);
+	SelectObject(hDC, hOldPen);
+
+	return true;
+}
+
+bool GameEngine::DrawLines(const POINT ptsArr[], int nrLines) const
+{
+	if (m_IsDoublebuffering || m_IsPainting) return DrawLines(ptsArr, nrLines, m_HdcDraw);
+	else return false;
+}
+
 bool GameEngine::DrawPolygon(const POINT ptsArr[], int count, bool close, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 
 	FormPolygon(ptsArr, count, close, hDC);
 
 	SelectObject(hDC, hOldPen);
-	DeleteObject(hNewPen);	
 
 	return true;
 }
@@ -610,10 +644,8 @@ bool GameEngine::DrawPolygon(const POINT ptsArr[], int count) const
 
 bool GameEngine::FillPolygon(const POINT ptsArr[], int count, bool close, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	HBRUSH hOldBrush, hNewBrush = CreateSolidBrush(m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
-	hOldBrush = (HBRUSH) SelectObject(hDC, hNewBrush);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
+	HBRUSH hOldBrush = (HBRUSH) SelectObject(hDC, GetDrawBrush());
 
 	BeginPath(hDC);
 
@@ -625,9 +657,6 @@ bool GameEngine::FillPolygon(const POINT ptsArr[], int count, bool close, HDC hD
 	SelectObject(hDC, hOldPen);
 	SelectObject(hDC, hOldBrush);
 
-	DeleteObject(hNewPen);
-	DeleteObject(hNewBrush);
-
 	return true;
 }
 
@@ -660,14 +689,12 @@ void GameEngine::FormPolygon(const POINT ptsArr[], int count, bool close, HDC hD
 
 bool GameEngine::DrawRect(int x, int y, int width, int height, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
-	POINT pts[4] = {x, m_Height - y, x + width -1, m_Height - y, x + width-1, m_Height - (y + height-1), x, m_Height - (y + height-1)};
-	DrawPolygon(pts, 4, true, hDC);
+	POINT pts[5] = {x, m_Height - y, x + width -1, m_Height - y, x + width-1, m_Height - (y + height-1), x, m_Height - (y + height-1), x, m_Height - y};
+	Polyline(hDC, pts, 5);
 
 	SelectObject(hDC, hOldPen);
-	DeleteObject(hNewPen);	
 
 	return true;
 }
@@ -678,22 +705,47 @@ bool GameEngine::DrawRect(int x, int y, int width, int height) const
 	else return false;
 }
 
-bool GameEngine::FillRect(int x, int y, int width, int height, HDC hDC) const
+bool GameEngine::DrawRects(const RECT rectsArr[], int count, HDC hDC) const
+{
+	if (count <= 0) return true;
+
+	// every rect is a closed polyline of 5 points, on the same pixels as DrawRect
+	m_BatchPoints.resize(count * 5);
+	for (int i = 0; i < count; ++i)
+	{
+		const RECT& rect = rectsArr[i];
+		POINT* pts = &m_BatchPoints[i * 5];
+		pts[0].x = rect.left;		pts[0].y = m_Height - rect.top;
+		pts[1].x = rect.right - 1;	pts[1].y = m_Height - rect.top;
+		pts[2].x = rect.right - 1;	pts[2].y = m_Height - (rect.bottom - 1);
+		pts[3].x = rect.left;		pts[3].y = m_Height - (rect.bottom - 1);
+		pts[4] = pts[0];
+	}
+	m_BatchCounts.assign(count, 5);
+
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
+	PolyPolyline(hDC, m_BatchPoints.data(), m_BatchCounts.data(), count);
+	SelectObject(hDC, hOldPen);
+
+	return true;
+}
+
+bool GameEngine::DrawRects(const RECT rectsArr[], int count) const
 {
-	HBRUSH hOldBrush, hNewBrush = CreateSolidBrush(m_ColDraw);
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
+	if (m_IsDoublebuffering || m_IsPainting) return DrawRects(rectsArr, count, m_HdcDraw);
+	else return false;
+}
 
-	hOldBrush = (HBRUSH) SelectObject(hDC, hNewBrush);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+bool GameEngine::FillRect(int x, int y, int width, int height, HDC hDC) const
+{
+	HBRUSH hOldBrush = (HBRUSH) SelectObject(hDC, GetDrawBrush());
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
 	Rectangle(hDC, x, m_Height - y, x + width, m_Height - (y + height));
 						
 	SelectObject(hDC, hOldPen);
 	SelectObject(hDC, hOldBrush);
 
-	DeleteObject(hNewPen);
-	DeleteObject(hNewBrush);
-
 	return true;
 }
 
@@ -728,12 +780,10 @@ bool GameEngine::FillRect(int x, int y, int width, int height, int opacity) cons
 
 	//SetDCPenColor(tempHdc, RGB(0,0,255));
 	//SetDCBrushColor(tempHdc, RGB(0,0,255));
-	HBRUSH fillBrush = CreateSolidBrush(m_ColDraw);
-	::FillRect(tempHdc, &dim, fillBrush);
+	::FillRect(tempHdc, &dim, GetDrawBrush());
 
 	AlphaBlend(m_HdcDraw, x, m_Height - y, width, height, tempHdc, dim.left, dim.top, dim.right, dim.bottom, blend);
 
-	DeleteObject(fillBrush);
 	DeleteObject(hbitmap);
 	DeleteObject(tempHdc);
 
@@ -748,8 +798,7 @@ bool GameEngine::FillRect(int x, int y, int width, int height) const
 
 bool GameEngine::DrawRoundRect(int x, int y, int width, int height, int radius, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
 	BeginPath(hDC);
 
@@ -759,7 +808,6 @@ bool GameEngine::DrawRoundRect(int x, int y, int width, int height, int radius,
 	StrokePath(hDC);
 
 	SelectObject(hDC, hOldPen);
-	DeleteObject(hNewPen);	
 
 	return true;
 }
@@ -772,20 +820,14 @@ bool GameEngine::DrawRoundRect(int x, int y, int width, int height, int radius)
 
 bool GameEngine::FillRoundRect(int x, int y, int width, int height, int radius, HDC hDC) const
 {
-	HBRUSH hOldBrush, hNewBrush = CreateSolidBrush(m_ColDraw);
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-
-	hOldBrush = (HBRUSH) SelectObject(hDC, hNewBrush);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HBRUSH hOldBrush = (HBRUSH) SelectObject(hDC, GetDrawBrush());
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
 	RoundRect(hDC, x, m_Height - y, x + width, m_Height - (y + height), radius, radius);
 						
 	SelectObject(hDC, hOldPen);
 	SelectObject(hDC, hOldBrush);
 
-	DeleteObject(hNewPen);
-	DeleteObject(hNewBrush);
-
 	return true;
 }
 
@@ -797,13 +839,11 @@ bool GameEngine::FillRoundRect(int x, int y, int width, int height, int radius)
 
 bool GameEngine::DrawOval(int x, int y, int width, int height, HDC hDC) const
 {
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
 	Arc(hDC, x, m_Height - y, x + width, m_Height - (y + height), x, m_Height - (y + height/2), x, m_Height - (y + height/2));
 
 	SelectObject(hDC, hOldPen);
-	DeleteObject(hNewPen);	
 
 	return true;
 }
@@ -816,20 +856,14 @@ bool GameEngine::DrawOval(int x, int y, int width, int height) const
 
 bool GameEngine::FillOval(int x, int y, int width, int height, HDC hDC) const
 {
-	HBRUSH hOldBrush, hNewBrush = CreateSolidBrush(m_ColDraw);
-	HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-
-	hOldBrush = (HBRUSH) SelectObject(hDC, hNewBrush);
-	hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+	HBRUSH hOldBrush = (HBRUSH) SelectObject(hDC, GetDrawBrush());
+	HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 	
 	Ellipse(hDC, x, m_Height - y, x + width, m_Height - (y + height));
 						
 	SelectObject(hDC, hOldPen);
 	SelectObject(hDC, hOldBrush);
 
-	DeleteObject(hNewPen);
-	DeleteObject(hNewBrush);
-
 	return true;
 }
 
@@ -913,8 +947,7 @@ bool GameEngine::DrawArc(int x, int y, int width, int height, int startDegree, i
 	if (angle > 360) { DrawOval(x, y, width, height, hDC); }
 	else
 	{
-		HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-		hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+		HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 		
 		POINT ptStart = AngleToPoint(x, y, width, height, startDegree);
 		POINT ptEnd = AngleToPoint(x, y, width, height, startDegree + angle);
@@ -923,7 +956,6 @@ bool GameEngine::DrawArc(int x, int y, int width, int height, int startDegree, i
 		else Arc(hDC, x, m_Height - y, x + width, m_Height - (y + height), ptEnd.x, m_Height - ptEnd.y, ptStart.x, m_Height - ptStart.y);
 
 		SelectObject(hDC, hOldPen);
-		DeleteObject(hNewPen);	
 	}
 
 	return true;
@@ -941,11 +973,8 @@ bool GameEngine::FillArc(int x, int y, int width, int height, int startDegree, i
 	if (angle > 360) { FillOval(x, y, width, height, hDC); }
 	else
 	{
-		HBRUSH hOldBrush, hNewBrush = CreateSolidBrush(m_ColDraw);
-		HPEN hOldPen, hNewPen = CreatePen(PS_SOLID, 1, m_ColDraw);
-
-		hOldBrush = (HBRUSH) SelectObject(hDC, hNewBrush);
-		hOldPen = (HPEN) SelectObject(hDC, hNewPen);
+		HBRUSH hOldBrush = (HBRUSH) SelectObject(hDC, GetDrawBrush());
+		HPEN hOldPen = (HPEN) SelectObject(hDC, GetDrawPen());
 
 		POINT ptStart = AngleToPoint(x, y, width, height, startDegree);
 		POINT ptEnd = AngleToPoint(x, y, width, height, startDegree + angle);
@@ -955,9 +984,6 @@ bool GameEngine::FillArc(int x, int y, int width, int height, int startDegree, i
 
 		SelectObject(hDC, hOldPen);
 		SelectObject(hDC, hOldBrush);
-
-		DeleteObject(hNewPen);
-		DeleteObject(hNewBrush);
 	}
 
 	return true;
@@ -970,6 +996,50 @@ bool GameEngine::FillArc(int x, int y, int width, int height, int startDegree, i
 	else return false;
 }
 
+HPEN GameEngine::GetDrawPen() const
+{
+	// reuse the pen of this color if it was created before
+	for (int i = 0; i < m_PenCache.nrObjects; ++i)
+	{
+		if (m_PenCache.colors[i] == m_ColDraw) return (HPEN) m_PenCache.objects[i];
+	}
+
+	// replace the oldest pen when the cache is full
+	int idx = m_PenCache.nextObject;
+	if (m_PenCache.nrObjects < (int) _countof(m_PenCache.objects)) idx = m_PenCache.nrObjects++;
+	else
+	{
+		DeleteObject(m_PenCache.objects[idx]);
+		m_PenCache.nextObject = (idx + 1) % (int) _countof(m_PenCache.objects);
+	}
+
+	m_PenCache.colors[idx] = m_ColDraw;
+	m_PenCache.objects[idx] = CreatePen(PS_SOLID, 1, m_ColDraw);
+	return (HPEN) m_PenCache.objects[idx];
+}
+
+HBRUSH GameEngine::GetDrawBrush() const
+{
+	// reuse the brush of this color if it was created before
+	for (int i = 0; i < m_BrushCache.nrObjects; ++i)
+	{
+		if (m_BrushCache.colors[i] == m_ColDraw) return (HBRUSH) m_BrushCache.objects[i];
+	}
+
+	// replace the oldest brush when the cache is full
+	int idx = m_BrushCache.nextObject;
+	if (m_BrushCache.nrObjects < (int) _countof(m_BrushCache.objects)) idx = m_BrushCache.nrObjects++;
+	else
+	{
+		DeleteObject(m_BrushCache.objects[idx]);
+		m_BrushCache.nextObject = (idx + 1) % (int) _countof(m_BrushCache.objects);
+	}
+
+	m_BrushCache.colors[idx] = m_ColDraw;
+	m_BrushCache.objects[idx] = CreateSolidBrush(m_ColDraw);
+	return (HBRUSH) m_BrushCache.objects[idx];
+}
+
 POINT GameEngine::AngleToPoint(int x, int y, int width, int height, int angle) const
 {
 	POINT pt;
@@ -1150,6 +1220,56 @@ bool GameEngine::DrawSolidBackground(COLORREF color, HDC hDC, RECT rect)
 	return true;
 }
 
+bool GameEngine::BeginCachedLayer()
+{
+	if (!(m_IsDoublebuffering || m_IsPainting) || m_HdcDrawBeforeLayer != 0) return false;
+
+	// (re)create the layer if the window changed size
+	if (m_HdcLayer == 0 || m_LayerWidth != m_Width || m_LayerHeight != m_Height)
+	{
+		if (m_HdcLayer != 0)
+		{
+			SelectObject(m_HdcLayer, m_HOldBmpLayer);
+			DeleteObject(m_HBmpLayer);
+			DeleteDC(m_HdcLayer);
+		}
+
+		m_HdcLayer = CreateCompatibleDC(m_HdcDraw);
+		m_HBmpLayer = CreateCompatibleBitmap(m_HdcDraw, m_Width, m_Height);
+		m_HOldBmpLayer = (HBITMAP) SelectObject(m_HdcLayer, m_HBmpLayer);
+		m_LayerWidth = m_Width;
+		m_LayerHeight = m_Height;
+	}
+
+	// start from the same black background as the paint buffer
+	PatBlt(m_HdcLayer, 0, 0, m_LayerWidth, m_LayerHeight, BLACKNESS);
+
+	// every draw method now draws on the layer
+	m_HdcDrawBeforeLayer = m_HdcDraw;
+	m_HdcDraw = m_HdcLayer;
+
+	return true;
+}
+
+bool GameEngine::EndCachedLayer()
+{
+	if (m_HdcDrawBeforeLayer == 0) return false;
+
+	m_HdcDraw = m_HdcDrawBeforeLayer;
+	m_HdcDrawBeforeLayer = 0;
+
+	return true;
+}
+
+bool GameEngine::DrawCachedLayer() const
+{
+	if (!(m_IsDoublebuffering || m_IsPainting) || m_HdcLayer == 0) return false;
+
+	BitBlt(m_HdcDraw, 0, 0, m_LayerWidth, m_LayerHeight, m_HdcLayer, 0, 0, SRCCOPY);
+
+	return true;
+}
+
 bool GameEngine::DrawSolidBackground(COLORREF color)
 {	
 	if (m_IsDoublebuffering || m_IsPainting) return DrawSolidBackground(color, m_HdcDraw, m_RectDraw);
@@ -108,6 +108,8 @@ public:
 	// Draw Methods
 	bool		DrawLine(int x1, int y1, int x2, int y2) const;
 	bool		DrawLine(int x1, int y1, int x2, int y2, HDC hDC) const;
+	bool		DrawLines(const POINT ptsArr[], int nrLines) const;						// every line is 2 points in ptsArr
+	bool		DrawLines(const POINT ptsArr[], int nrLines, HDC hDC) const;
 	bool		DrawPolygon(const POINT ptsArr[], int count) const;
 	bool		DrawPolygon(const POINT ptsArr[], int count, bool close) const;
 	bool		DrawPolygon(const POINT ptsArr[], int count, bool close, HDC hDC) const;
@@ -116,6 +118,8 @@ public:
 	bool		FillPolygon(const POINT ptsArr[], int count, bool close, HDC hDC) const;
 	bool		DrawRect(int x, int y, int width, int height) const;
 	bool		DrawRect(int x, int y, int width, int height, HDC hDC) const;
+	bool		DrawRects(const RECT rectsArr[], int count) const;						// left = x, top = y, right = x + width, bottom = y + height
+	bool		DrawRects(const RECT rectsArr[], int count, HDC hDC) const;
 	bool		FillRect(int x, int y, int width, int height) const;
 	bool		FillRect(int x, int y, int width, int height, int opacity) const;
 	bool		FillRect(int x, int y, int width, int height, HDC hDC) const;
@@ -147,6 +151,11 @@ public:
 	void		SetFont(Font* fontPtr);
 	bool		Repaint() const;
 
+	// Cached Layer Methods, draws between BeginCachedLayer and EndCachedLayer end up in an offscreen bitmap that can be copied every paint
+	bool		BeginCachedLayer();
+	bool		EndCachedLayer();
+	bool		DrawCachedLayer() const;
+
 	// Accessor Methods
 	HINSTANCE	GetInstance()	const	{ return m_hInstance; }
 	HWND		GetWindow()		const	{ return m_Window; }
@@ -180,6 +189,8 @@ private:
 	// Private Draw Methods
 	void		FormPolygon(const POINT ptsArr[], int count, bool close, HDC hDC)	const;
 	POINT		AngleToPoint(int x, int y, int width, int height, int angle)		const;
+	HPEN		GetDrawPen()														const;
+	HBRUSH		GetDrawBrush()														const;
 
 	// Member Variables
 	HINSTANCE           m_hInstance{};
@@ -205,6 +216,28 @@ private:
 	COLORREF			m_ColDraw{};
 	HFONT				m_FontDraw{};
 
+	// GDI object cache, a pen or brush is only created the first time a color is drawn with
+	struct GdiObjectCache
+	{
+		COLORREF			colors[16]{};
+		HGDIOBJ				objects[16]{};
+		int					nrObjects{};
+		int					nextObject{};		// the object that is replaced when the cache is full
+	};
+	mutable GdiObjectCache	m_PenCache{};
+	mutable GdiObjectCache	m_BrushCache{};
+
+	// Scratch buffers of the batched draw methods
+	mutable vector<POINT>	m_BatchPoints{};
+	mutable vector<DWORD>	m_BatchCounts{};
+
+	// Cached layer assistance variables
+	HDC					m_HdcLayer{};
+	HBITMAP				m_HBmpLayer{};
+	HBITMAP				m_HOldBmpLayer{};
+	HDC					m_HdcDrawBeforeLayer{};
+	int					m_LayerWidth{}, m_LayerHeight{};
+
 	// Fullscreen assistance variable
 	POINT				m_OldLoc{};
 
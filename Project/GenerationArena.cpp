@@ -0,0 +1,74 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "GenerationArena.h"
+#include <cstdint>
+
+//---------------------------
+// Constructor
+//---------------------------
+GenerationArena::GenerationArena(size_t blockSize)
+	: m_BlockSize{ blockSize }
+{
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void* GenerationArena::Allocate(size_t size, size_t alignment)
+{
+	++m_NrAllocations;
+
+	// Use the next blocks until one of them has enough space left
+	while (true)
+	{
+		// No block is big enough, add a block that fits at least this allocation
+		if (m_CurBlock == m_Blocks.size()) AddBlock(size + alignment > m_BlockSize ? size + alignment : m_BlockSize);
+
+		const Block& block{ m_Blocks[m_CurBlock] };
+
+		// Align the address, not the offset, so alignments bigger than the alignment of the block also work
+		const uintptr_t start{ reinterpret_cast<uintptr_t>(block.pMemory.get()) };
+		const uintptr_t alignedAddress{ (start + m_CurOffset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1) };
+		const size_t alignedOffset{ static_cast<size_t>(alignedAddress - start) };
+
+		if (alignedOffset + size <= block.size)
+		{
+			m_CurOffset = alignedOffset + size;
+			return block.pMemory.get() + alignedOffset;
+		}
+
+		++m_CurBlock;
+		m_CurOffset = 0;
+	}
+}
+
+void GenerationArena::Reset()
+{
+	m_NrAllocations = 0;
+	m_CurBlock = 0;
+	m_CurOffset = 0;
+
+	// Usually everything fits in one block and resetting only moves back to the start
+	if (m_Blocks.size() <= 1) return;
+
+	// Replace every block by one block as big as all of them together
+	size_t totalSize{};
+	for (const Block& block : m_Blocks)
+	{
+		totalSize += block.size;
+	}
+
+	m_Blocks.clear();
+	AddBlock(totalSize);
+}
+
+void GenerationArena::AddBlock(size_t size)
+{
+	++m_NrBlockAllocations;
+
+	Block block{};
+	block.pMemory = std::make_unique<unsigned char[]>(size);
+	block.size = size;
+	m_Blocks.push_back(std::move(block));
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+//-----------------------------------------------------
+// GenerationArena Class
+//-----------------------------------------------------
+// Hands out the memory of the scratch containers of one generation, the memory is only given back all at once by Reset
+// The interface follows std::pmr::memory_resource, so a std::pmr::monotonic_buffer_resource can take its place once the project uses C++17
+class GenerationArena final
+{
+public:
+	explicit GenerationArena(size_t blockSize = 64 * 1024);	// Constructor
+	~GenerationArena() = default;							// Destructor
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	GenerationArena(const GenerationArena& other) = delete;
+	GenerationArena(GenerationArena&& other) noexcept = delete;
+	GenerationArena& operator=(const GenerationArena& other) = delete;
+	GenerationArena& operator=(GenerationArena&& other) noexcept = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	void* Allocate(size_t size, size_t alignment);
+	void Deallocate(void*, size_t, size_t) {}	// Memory is only given back by Reset
+
+	// Makes every block available again, if one generation needed more than one block they are replaced by one block that fits everything
+	void Reset();
+
+	// The amount of allocations since the last reset
+	int GetAllocationCount() const { return m_NrAllocations; }
+	// The amount of blocks that have been allocated from the heap since the arena was created
+	int GetBlockAllocationCount() const { return m_NrBlockAllocations; }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	void AddBlock(size_t size);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	struct Block
+	{
+		std::unique_ptr<unsigned char[]> pMemory{};
+		size_t size{};
+	};
+
+	std::vector<Block> m_Blocks{};
+	size_t m_CurBlock{};
+	size_t m_CurOffset{};
+	const size_t m_BlockSize;
+
+	int m_NrAllocations{};
+	int m_NrBlockAllocations{};
+};
+
+//-----------------------------------------------------
+// ArenaAllocator Class
+//-----------------------------------------------------
+// Lets a standard container allocate from a generation arena, the container has to be destroyed or cleared before the arena is reset
+// Not final, standard containers are allowed to derive from their allocator
+template<typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	ArenaAllocator(GenerationArena& arena) : m_pArena{ &arena } {}
+	template<typename U> ArenaAllocator(const ArenaAllocator<U>& other) : m_pArena{ other.GetArena() } {}
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	T* allocate(size_t count) { return static_cast<T*>(m_pArena->Allocate(count * sizeof(T), alignof(T))); }
+	void deallocate(T* pMemory, size_t count) { m_pArena->Deallocate(pMemory, count * sizeof(T), alignof(T)); }
+
+	GenerationArena* GetArena() const { return m_pArena; }
+
+	template<typename U> bool operator==(const ArenaAllocator<U>& other) const { return m_pArena == other.GetArena(); }
+	template<typename U> bool operator!=(const ArenaAllocator<U>& other) const { return m_pArena != other.GetArena(); }
+
+private:
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	GenerationArena* m_pArena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,60 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "GenerationEventQueue.h"
+
+//---------------------------
+// Constructor
+//---------------------------
+GenerationEventQueue::GenerationEventQueue(size_t capacity)
+	: m_Events(RoundUpToPowerOfTwo(capacity))
+	, m_Mask{ m_Events.size() - 1 }
+{
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void GenerationEventQueue::OnGenerationEvent(const GenerationEvent& event)
+{
+	const size_t writeIdx{ m_WriteIdx.load(std::memory_order_relaxed) };
+
+	// If the queue looks full, check how far the reader has come
+	if (writeIdx - m_CachedReadIdx == m_Events.size())
+	{
+		m_CachedReadIdx = m_ReadIdx.load(std::memory_order_acquire);
+		if (writeIdx - m_CachedReadIdx == m_Events.size())
+		{
+			m_NrDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	// Write the event before publishing it
+	m_Events[writeIdx & m_Mask] = event;
+	m_WriteIdx.store(writeIdx + 1, std::memory_order_release);
+}
+
+bool GenerationEventQueue::Pop(GenerationEvent& event)
+{
+	const size_t readIdx{ m_ReadIdx.load(std::memory_order_relaxed) };
+
+	// If the queue looks empty, check how far the generator has come
+	if (readIdx == m_CachedWriteIdx)
+	{
+		m_CachedWriteIdx = m_WriteIdx.load(std::memory_order_acquire);
+		if (readIdx == m_CachedWriteIdx) return false;
+	}
+
+	// Read the event before giving its slot back
+	event = m_Events[readIdx & m_Mask];
+	m_ReadIdx.store(readIdx + 1, std::memory_order_release);
+	return true;
+}
+
+size_t GenerationEventQueue::RoundUpToPowerOfTwo(size_t value)
+{
+	size_t powerOfTwo{ 1 };
+	while (powerOfTwo < value) powerOfTwo <<= 1;
+	return powerOfTwo;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <vector>
+#include <atomic>
+#include "GenerationListener.h"
+
+//-----------------------------------------------------
+// GenerationEventQueue Class
+//-----------------------------------------------------
+// Passes the events of a generation from the thread that generates to one other thread without locking
+// Only the generating thread may add events and only one other thread may take them out
+// The generator never waits for the other thread, events that don't fit anymore are dropped and counted
+class GenerationEventQueue final : public GenerationListener
+{
+public:
+	// The capacity is rounded up to a power of two
+	explicit GenerationEventQueue(size_t capacity = 1 << 16);	// Constructor
+	virtual ~GenerationEventQueue() = default;					// Destructor
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	GenerationEventQueue(const GenerationEventQueue& other) = delete;
+	GenerationEventQueue(GenerationEventQueue&& other) noexcept = delete;
+	GenerationEventQueue& operator=(const GenerationEventQueue& other) = delete;
+	GenerationEventQueue& operator=(GenerationEventQueue&& other) noexcept = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	// Called by the generating thread
+	virtual void OnGenerationEvent(const GenerationEvent& event) override;
+
+	// Called by the reading thread, returns false if there are no events
+	bool Pop(GenerationEvent& event);
+
+	// The amount of events that didn't fit, the reader can't follow the generation anymore once this is not 0
+	int GetDroppedCount() const { return m_NrDroppedEvents.load(std::memory_order_relaxed); }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	static size_t RoundUpToPowerOfTwo(size_t value);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	// The size of a cache line, the indices of both threads are kept on seperate cache lines so they don't slow each other down
+	static constexpr size_t m_CacheLineSize{ 64 };
+
+	std::vector<GenerationEvent> m_Events;
+	const size_t m_Mask;
+
+	// Used by the generating thread, the read index is only loaded again when the queue looks full
+	std::atomic<size_t> m_WriteIdx{};
+	size_t m_CachedReadIdx{};
+	char m_WritePadding[m_CacheLineSize]{};
+
+	// Used by the reading thread, the write index is only loaded again when the queue looks empty
+	std::atomic<size_t> m_ReadIdx{};
+	size_t m_CachedWriteIdx{};
+	char m_ReadPadding[m_CacheLineSize]{};
+
+	std::atomic<int> m_NrDroppedEvents{};
+};
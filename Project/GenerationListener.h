@@ -0,0 +1,73 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include "DataTypes.h"
+
+// Everything the generator reports while it generates, in the order it happens
+// Room indices are the indices of the rooms of the generator at that moment, the rooms of the dungeon once the triangulation starts
+enum class GenerationEventType
+{
+	// A new generation started, every room, triangle and connection of the previous generation is gone
+	GenerationStarted,
+	// Room index was added at position with size
+	RoomCreated,
+	// Room index moved to position
+	RoomMoved,
+	// Seperation pass index has finished, every room that moved during the pass has been reported
+	SeperationPassFinished,
+	// Room index will be removed with the next RoomsRemoved, index is the index before any room is removed
+	RoomDiscarded,
+	// Every discarded room is removed, the rooms that are left keep their order
+	RoomsRemoved,
+	// Every room and spanning tree edge is removed, a retry reports the rooms it starts from with RoomCreated
+	RoomsCleared,
+	// Triangle index now connects rooms 0, 1 and 2, a room of -1 is a corner of the super triangle
+	TriangleSet,
+	// Triangle index is removed, the last triangle is moved to index
+	TriangleRemoved,
+	// Every triangle is removed
+	TrianglesCleared,
+	// The minimum spanning tree connects room 0 and room 1
+	SpanningTreeEdgeAdded,
+	// Room index is a corridor at position with size, it is part of the corridor between room 0 and room 1
+	CorridorCreated,
+	// Room 0 and room 1 are connected
+	RoomsConnected,
+	// Room 0 is the start and room 1 is the end of the dungeon
+	StartAndEndChosen,
+	// The layout is finished, keys and locked rooms are reported after this event
+	GenerationFinished,
+	// Room index has a key
+	KeyPlaced,
+	// Room index is locked
+	LockedRoomPlaced
+};
+
+// One change of the generation, small enough to be copied into a queue
+struct GenerationEvent
+{
+	GenerationEventType type{};
+	int index{};
+	int rooms[3]{};
+	Vector2 position{};
+	Vector2 size{};
+};
+
+//-----------------------------------------------------
+// GenerationListener Class
+//-----------------------------------------------------
+// Receives every change of a generation while it happens, on the thread that generates the dungeon
+// Without a listener the generator doesn't create any events
+class GenerationListener
+{
+public:
+	GenerationListener() = default;
+	virtual ~GenerationListener() = default;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	virtual void OnGenerationEvent(const GenerationEvent& event) = 0;
+};
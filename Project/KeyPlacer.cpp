@@ -0,0 +1,190 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "KeyPlacer.h"
+#include "Profiler.h"
+#include <algorithm>
+
+//---------------------------
+// Constructor
+//---------------------------
+KeyPlacer::KeyPlacer(const std::vector<DungeonRoom>& rooms, const AdjacencyList& connections, int startIdx, int endIdx, GenerationArena& arena)
+	: m_Rooms{ rooms }
+	, m_Connections{ connections }
+	, m_StartIdx{ startIdx }
+	, m_EndIdx{ endIdx }
+	, m_Arena{ arena }
+	, m_Path{ arena }
+	, m_Parents{ arena }
+	, m_BranchPathIdx{ arena }
+	, m_IsTaken{ arena }
+	, m_HasKeyBehind{ arena }
+{
+	BuildTree();
+}
+
+//---------------------------
+// Member functions
+//---------------------------
+void KeyPlacer::Place(RandomGenerator& random, int nrKeys, bool needAllKeys, ArenaVector<int>& keyRooms, ArenaVector<int>& lockedRooms)
+{
+	// The path needs at least one room between the start and the end to place a locked room in
+	const int lastDoorPathIdx{ static_cast<int>(m_Path.size()) - 2 };
+	if (lastDoorPathIdx < 1) return;
+
+	// The arena never gives memory back, so both candidate lists get their biggest size up front instead of growing
+	ArenaVector<int> keyCandidates{ m_Arena };
+	ArenaVector<int> doorCandidates{ m_Arena };
+	keyCandidates.reserve(m_Rooms.size());
+	doorCandidates.reserve(m_Path.size());
+
+	// For every key
+	for (int i{}; i < nrKeys; ++i)
+	{
+		PROFILE_COUNT(KeyPlacementTries, 1);
+
+		// Find the furthest room on the path that can still be locked, every key has to be reached before its locked room
+		int maxDoorPathIdx{ -1 };
+		for (int pathIdx{ lastDoorPathIdx }; pathIdx >= 1; --pathIdx)
+		{
+			if (m_IsTaken[m_Path[pathIdx]]) continue;
+
+			maxDoorPathIdx = pathIdx;
+			break;
+		}
+
+		// Find every room that is not the start or the end that branches off the path before that locked room
+		// If all keys are needed, keys are placed in leaf rooms (only 1 connection) while there are leaf rooms available
+		keyCandidates.clear();
+		bool hasOnlyLeafRooms{};
+		for (int roomIdx{}; roomIdx < static_cast<int>(m_Rooms.size()); ++roomIdx)
+		{
+			if (m_IsTaken[roomIdx] || roomIdx == m_StartIdx || roomIdx == m_EndIdx) continue;
+			if (m_BranchPathIdx[roomIdx] < 0 || m_BranchPathIdx[roomIdx] >= maxDoorPathIdx) continue;
+			if (m_HasKeyBehind[roomIdx] || IsBehindKey(roomIdx)) continue;
+
+			const bool isLeafRoom{ m_Connections.GetDegree(roomIdx) == 1 };
+			if (needAllKeys && isLeafRoom && !hasOnlyLeafRooms)
+			{
+				// The first leaf room has been found, forget every other room
+				keyCandidates.clear();
+				hasOnlyLeafRooms = true;
+			}
+			if (hasOnlyLeafRooms && !isLeafRoom) continue;
+
+			keyCandidates.push_back(roomIdx);
+		}
+
+		PROFILE_COUNT(KeyCandidates, static_cast<long long>(keyCandidates.size()));
+
+		// If no room is left for a key, stop placing keys
+		if (keyCandidates.empty()) break;
+
+		const int keyRoomIdx{ keyCandidates[random.RandomInt(0, static_cast<int>(keyCandidates.size()) - 1)] };
+
+		// Find every room on the path after the room the key branches off, these rooms are never leaf rooms
+		doorCandidates.clear();
+		for (int pathIdx{ m_BranchPathIdx[keyRoomIdx] + 1 }; pathIdx <= maxDoorPathIdx; ++pathIdx)
+		{
+			const int roomIdx{ m_Path[pathIdx] };
+			if (m_IsTaken[roomIdx] || roomIdx == keyRoomIdx) continue;
+
+			doorCandidates.push_back(roomIdx);
+		}
+
+		const int doorRoomIdx{ doorCandidates[random.RandomInt(0, static_cast<int>(doorCandidates.size()) - 1)] };
+
+		// Save the found key and locked room
+		MarkKey(keyRoomIdx);
+		m_IsTaken[doorRoomIdx] = true;
+		keyRooms.push_back(keyRoomIdx);
+		lockedRooms.push_back(doorRoomIdx);
+	}
+}
+
+void KeyPlacer::BuildTree()
+{
+	const int nrRooms{ static_cast<int>(m_Rooms.size()) };
+
+	m_Path.clear();
+	m_Parents.assign(nrRooms, -1);
+	m_BranchPathIdx.assign(nrRooms, -1);
+	m_IsTaken.assign(nrRooms, false);
+	m_HasKeyBehind.assign(nrRooms, false);
+
+	if (m_StartIdx < 0 || m_EndIdx < 0) return;
+
+	// Find the parent of every room that can be reached from the start
+	// The dungeon is a tree, so the first way a room is found is the only way to get there
+	// Rooms are added to the order as they are found, so the order is also the queue of the breadth first search
+	ArenaVector<int> order{ m_Arena };
+	order.reserve(nrRooms);
+
+	ArenaVector<bool> isVisited(nrRooms, false, m_Arena);
+	order.push_back(m_StartIdx);
+	isVisited[m_StartIdx] = true;
+
+	for (size_t orderIdx{}; orderIdx < order.size(); ++orderIdx)
+	{
+		const int roomIdx{ order[orderIdx] };
+
+		for (int connection : m_Connections.GetNeighbours(roomIdx))
+		{
+			if (isVisited[connection]) continue;
+
+			isVisited[connection] = true;
+			m_Parents[connection] = roomIdx;
+			order.push_back(connection);
+		}
+	}
+
+	// If the end can't be reached, no keys can be placed
+	if (!isVisited[m_EndIdx]) return;
+
+	// Walk back from the end to the start to find the path
+	m_Path.reserve(nrRooms);
+	for (int roomIdx{ m_EndIdx }; roomIdx >= 0; roomIdx = m_Parents[roomIdx])
+	{
+		m_Path.push_back(roomIdx);
+	}
+	std::reverse(m_Path.begin(), m_Path.end());
+
+	for (int pathIdx{}; pathIdx < static_cast<int>(m_Path.size()); ++pathIdx)
+	{
+		m_BranchPathIdx[m_Path[pathIdx]] = pathIdx;
+	}
+
+	// Every other room branches off the same path room as its parent, parents are always found before their children
+	for (int roomIdx : order)
+	{
+		if (m_BranchPathIdx[roomIdx] >= 0) continue;
+
+		m_BranchPathIdx[roomIdx] = m_BranchPathIdx[m_Parents[roomIdx]];
+	}
+}
+
+bool KeyPlacer::IsBehindKey(int roomIdx) const
+{
+	// Walk back to the path, every side room that has been taken has a key
+	for (int parentIdx{ m_Parents[roomIdx] }; parentIdx >= 0; parentIdx = m_Parents[parentIdx])
+	{
+		if (m_Path[m_BranchPathIdx[parentIdx]] == parentIdx) return false;
+		if (m_IsTaken[parentIdx]) return true;
+	}
+	return false;
+}
+
+void KeyPlacer::MarkKey(int roomIdx)
+{
+	m_IsTaken[roomIdx] = true;
+
+	// Keys on the path don't block any rooms
+	if (m_Path[m_BranchPathIdx[roomIdx]] == roomIdx) return;
+
+	// Mark every side room between the key and the path
+	for (int parentIdx{ m_Parents[roomIdx] }; parentIdx >= 0; parentIdx = m_Parents[parentIdx])
+	{
+		if (m_Path[m_BranchPathIdx[parentIdx]] == parentIdx) return;
+		m_HasKeyBehind[parentIdx] = true;
+	}
+}
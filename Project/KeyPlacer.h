@@ -0,0 +1,66 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <vector>
+#include "DungeonRoom.h"
+#include "Utils.h"
+#include "GenerationArena.h"
+
+//-----------------------------------------------------
+// KeyPlacer Class
+//-----------------------------------------------------
+// Places keys and locked rooms in a dungeon that is a tree, without simulating a walk through the dungeon
+// Every locked room is placed on the path from the start to the end, and its key is placed in a room that is reached before that locked room
+// The dungeon solver walks along this path and only searches the side rooms when it is stopped by a locked room,
+// so it always picks up every key and opens every locked room before it reaches the end
+// The solver never returns to the rooms behind a picked up key, so a key is never placed behind another key
+// Every container of the placer is allocated from the arena of the generation, so the placer has to be destroyed before the arena is reset
+class KeyPlacer final
+{
+public:
+	KeyPlacer(const std::vector<DungeonRoom>& rooms, const AdjacencyList& connections, int startIdx, int endIdx, GenerationArena& arena);
+	~KeyPlacer() = default;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	// Places up to nrKeys keys and locked rooms, stops early if there are no rooms left to place them in
+	void Place(RandomGenerator& random, int nrKeys, bool needAllKeys, ArenaVector<int>& keyRooms, ArenaVector<int>& lockedRooms);
+
+	// The rooms from the start to the end, empty if the end can't be reached
+	IndexRange GetPath() const { return { m_Path.data(), m_Path.data() + m_Path.size() }; }
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	void BuildTree();
+	bool IsBehindKey(int roomIdx) const;
+	void MarkKey(int roomIdx);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	const std::vector<DungeonRoom>& m_Rooms;
+	const AdjacencyList& m_Connections;
+	const int m_StartIdx;
+	const int m_EndIdx;
+	GenerationArena& m_Arena;
+
+	// The rooms from the start to the end
+	ArenaVector<int> m_Path;
+
+	// The room every room is reached from, -1 for the start and rooms that can't be reached
+	ArenaVector<int> m_Parents;
+
+	// For every room, the index in the path of the path room it branches off, -1 if the room can't be reached from the start
+	ArenaVector<int> m_BranchPathIdx;
+
+	// Whether a room already has a key or a locked room
+	ArenaVector<bool> m_IsTaken;
+
+	// Whether a room leads to a key in a side room
+	ArenaVector<bool> m_HasKeyBehind;
+};
@@ -0,0 +1,101 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "Profiler.h"
+#include <cstdlib>
+#include <new>
+
+//---------------------------
+// Static datamembers
+//---------------------------
+std::atomic<long long> Profiler::m_Counts[static_cast<int>(Counter::Count)]{};
+std::atomic<long long> Profiler::m_TimeNanoseconds[static_cast<int>(Timer::Count)]{};
+
+//---------------------------
+// Member functions
+//---------------------------
+Profiler::Snapshot Profiler::TakeSnapshot()
+{
+	Snapshot snapshot{};
+	for (int counterIdx{}; counterIdx < static_cast<int>(Counter::Count); ++counterIdx)
+	{
+		snapshot.counts[counterIdx] = m_Counts[counterIdx].load(std::memory_order_relaxed);
+	}
+	return snapshot;
+}
+
+const char* Profiler::GetCounterName(Counter counter)
+{
+	switch (counter)
+	{
+	case Counter::TrianglesCreated: return "Triangles created";
+	case Counter::SolveCalls: return "Solve calls";
+	case Counter::SolveSteps: return "Solve steps";
+	case Counter::KeyPlacementTries: return "Key placement tries";
+	case Counter::KeyCandidates: return "Key candidate rooms";
+	case Counter::HeapAllocations: return "Heap allocations";
+	default: return "";
+	}
+}
+
+#ifdef DUNGEON_PROFILING
+//---------------------------
+// Global allocation functions
+//---------------------------
+// Every heap allocation of the program is counted, the memory itself comes from malloc like the default operator new
+void* operator new(size_t size)
+{
+	Profiler::AddCount(Profiler::Counter::HeapAllocations, 1);
+
+	// Every allocation returns a unique pointer, also when 0 bytes are asked
+	void* pMemory{ std::malloc(size > 0 ? size : 1) };
+	if (!pMemory) throw std::bad_alloc{};
+	return pMemory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	Profiler::AddCount(Profiler::Counter::HeapAllocations, 1);
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& nothrow) noexcept
+{
+	return operator new(size, nothrow);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	std::free(pMemory);
+}
+#endif
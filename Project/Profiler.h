@@ -0,0 +1,108 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <atomic>
+#include <chrono>
+
+// Profiling is part of every build without NDEBUG, it can be added to a release build by defining DUNGEON_PROFILING
+#if !defined(NDEBUG) && !defined(DUNGEON_PROFILING)
+#define DUNGEON_PROFILING
+#endif
+
+//-----------------------------------------------------
+// Profiler Class
+//-----------------------------------------------------
+// Counts what the generator and the solvers do and how long the frames take, for every thread together
+// Counters only go up, the difference between two snapshots is what happened between them
+// Use the PROFILE_COUNT and PROFILE_SCOPE macros, they are empty when profiling is compiled out
+class Profiler final
+{
+public:
+	enum class Counter
+	{
+		// Triangles set while triangulating, every triangle that has been replaced is counted again
+		TrianglesCreated,
+		// Calls to Solve of every solver
+		SolveCalls,
+		// Rooms every solver walked to
+		SolveSteps,
+		// Keys the key placer tried to place, a try fails when there is no room left for the key
+		KeyPlacementTries,
+		// Rooms the key placer could have put a key in
+		KeyCandidates,
+		// Calls to the global operator new
+		HeapAllocations,
+		Count
+	};
+
+	enum class Timer
+	{
+		Tick,
+		Paint,
+		Count
+	};
+
+	// The value of every counter at one moment
+	struct Snapshot
+	{
+		long long counts[static_cast<int>(Counter::Count)]{};
+	};
+
+	Profiler() = delete;
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	static void AddCount(Counter counter, long long amount) { m_Counts[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed); }
+	static long long GetCount(Counter counter) { return m_Counts[static_cast<int>(counter)].load(std::memory_order_relaxed); }
+	static Snapshot TakeSnapshot();
+
+	static void SetTime(Timer timer, double seconds) { m_TimeNanoseconds[static_cast<int>(timer)].store(static_cast<long long>(seconds * 1e9), std::memory_order_relaxed); }
+	// The duration of the last scope that was timed with this timer
+	static double GetTime(Timer timer) { return static_cast<double>(m_TimeNanoseconds[static_cast<int>(timer)].load(std::memory_order_relaxed)) / 1e9; }
+
+	static const char* GetCounterName(Counter counter);
+
+private:
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	static std::atomic<long long> m_Counts[static_cast<int>(Counter::Count)];
+	static std::atomic<long long> m_TimeNanoseconds[static_cast<int>(Timer::Count)];
+};
+
+//-----------------------------------------------------
+// ScopedProfileTimer Class
+//-----------------------------------------------------
+// Measures the time until the end of the scope and saves it in the profiler
+class ScopedProfileTimer final
+{
+public:
+	explicit ScopedProfileTimer(Profiler::Timer timer) : m_Timer{ timer }, m_Start{ std::chrono::steady_clock::now() } {}
+	~ScopedProfileTimer() { Profiler::SetTime(m_Timer, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count()); }
+
+	//---------------------------
+	// Disabling copy/move constructors and assignment operators
+	//---------------------------
+	ScopedProfileTimer(const ScopedProfileTimer& other) = delete;
+	ScopedProfileTimer(ScopedProfileTimer&& other) noexcept = delete;
+	ScopedProfileTimer& operator=(const ScopedProfileTimer& other) = delete;
+	ScopedProfileTimer& operator=(ScopedProfileTimer&& other) noexcept = delete;
+
+private:
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	const Profiler::Timer m_Timer;
+	const std::chrono::steady_clock::time_point m_Start;
+};
+
+#ifdef DUNGEON_PROFILING
+#define PROFILE_COUNT(counter, amount) Profiler::AddCount(Profiler::Counter::counter, amount)
+#define PROFILE_SCOPE(timer) const ScopedProfileTimer profileTimer##timer{ Profiler::Timer::timer }
+#else
+#define PROFILE_COUNT(counter, amount)
+#define PROFILE_SCOPE(timer)
+#endif
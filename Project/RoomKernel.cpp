@@ -0,0 +1,495 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "RoomKernel.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define ROOM_KERNEL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC allows every intrinsic in every function, other compilers need to know which functions may use them
+#if defined(ROOM_KERNEL_X86) && !defined(_MSC_VER)
+#define ROOM_KERNEL_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#define ROOM_KERNEL_TARGET(instructionSet)
+#endif
+
+//---------------------------
+// Member functions
+//---------------------------
+RoomKernel::InstructionSet RoomKernel::GetSupportedInstructionSet()
+{
+#ifdef ROOM_KERNEL_X86
+#ifdef _MSC_VER
+	// Read the feature flags of the processor
+	int cpuInfo[4]{};
+	__cpuid(cpuInfo, 0);
+	const int nrFunctions{ cpuInfo[0] };
+
+	__cpuid(cpuInfo, 1);
+	const bool hasSSE41{ (cpuInfo[2] & (1 << 19)) != 0 };
+	const bool hasOSXSave{ (cpuInfo[2] & (1 << 27)) != 0 };
+	const bool hasAVX{ (cpuInfo[2] & (1 << 28)) != 0 };
+
+	// AVX registers can only be used if the OS saves them
+	bool hasAVX2{};
+	if (nrFunctions >= 7 && hasOSXSave && hasAVX && (_xgetbv(0) & 0x6) == 0x6)
+	{
+		__cpuidex(cpuInfo, 7, 0);
+		hasAVX2 = (cpuInfo[1] & (1 << 5)) != 0;
+	}
+#else
+	__builtin_cpu_init();
+	const bool hasSSE41{ __builtin_cpu_supports("sse4.1") != 0 };
+	const bool hasAVX2{ __builtin_cpu_supports("avx2") != 0 };
+#endif
+
+	if (hasAVX2) return InstructionSet::AVX2;
+	if (hasSSE41) return InstructionSet::SSE41;
+#endif
+
+	return InstructionSet::Scalar;
+}
+
+RoomKernel::InstructionSet RoomKernel::ClampInstructionSet(InstructionSet instructionSet)
+{
+	// The processor is only checked once, it doesn't change while running
+	static const InstructionSet supportedInstructionSet{ GetSupportedInstructionSet() };
+
+	return static_cast<int>(instructionSet) > static_cast<int>(supportedInstructionSet) ? supportedInstructionSet : instructionSet;
+}
+
+const char* RoomKernel::GetInstructionSetName(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::SSE41:
+		return "SSE4.1";
+	case InstructionSet::AVX2:
+		return "AVX2";
+	default:
+		return "Scalar";
+	}
+}
+
+bool RoomKernel::AddSeperationDirection(InstructionSet instructionSet, const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction)
+{
+#ifdef ROOM_KERNEL_X86
+	switch (instructionSet)
+	{
+	case InstructionSet::AVX2:
+		return AddSeperationDirectionAVX2(rooms, idx, maxSpeed, direction);
+	case InstructionSet::SSE41:
+		return AddSeperationDirectionSSE41(rooms, idx, maxSpeed, direction);
+	default:
+		break;
+	}
+#endif
+
+	return AddSeperationDirectionScalar(rooms, idx, 0, maxSpeed, direction);
+}
+
+bool RoomKernel::IsBordering(InstructionSet instructionSet, const RoomStore& rooms, int idx, int minCorridorSize)
+{
+#ifdef ROOM_KERNEL_X86
+	switch (instructionSet)
+	{
+	case InstructionSet::AVX2:
+		return IsBorderingAVX2(rooms, idx, minCorridorSize);
+	case InstructionSet::SSE41:
+		return IsBorderingSSE41(rooms, idx, minCorridorSize);
+	default:
+		break;
+	}
+#endif
+
+	return IsBorderingScalar(rooms, idx, 0, minCorridorSize);
+}
+
+bool RoomKernel::AddSeperationDirectionScalar(const RoomStore& rooms, int idx, int firstIdx, int maxSpeed, Vector2& direction)
+{
+	// Whether any room overlaps with this room
+	bool isOverlapping{};
+
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// The bounds and the center of the current room
+	const int minX{ pX[idx] };
+	const int minY{ pY[idx] };
+	const int maxX{ pX[idx] + pWidth[idx] };
+	const int maxY{ pY[idx] + pHeight[idx] };
+	const Vector2 center{ rooms.GetCenter(idx) };
+
+	// For every other room
+	for (int j{ firstIdx }; j < nrRooms; ++j)
+	{
+		// If the other room is the same as the current room, continue to the next room
+		if (idx == j) continue;
+		// If the rooms are not overlapping, continue to the next room
+		if (!(minX < pX[j] + pWidth[j] && maxX > pX[j] && maxY > pY[j] && minY < pY[j] + pHeight[j])) continue;
+
+		isOverlapping = true;
+
+		// Calculate the direction between the rooms
+		Vector2 curDirection{ center - rooms.GetCenter(j) };
+		// Normalize the direction
+		curDirection.ToDirection();
+		// Rooms with the same center have no direction between them, they are pushed apart horizontally with the lowest index to the left
+		if (curDirection.x == 0 && curDirection.y == 0) curDirection.x = idx < j ? -1 : 1;
+
+		// Set the direction to max speed
+		curDirection *= maxSpeed;
+
+		// Add the current direction to the total direction
+		direction += curDirection;
+	}
+
+	return isOverlapping;
+}
+
+bool RoomKernel::IsBorderingScalar(const RoomStore& rooms, int idx, int firstIdx, int minCorridorSize)
+{
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// Get the center and the half size of the current room
+	const int centerX{ pX[idx] + pWidth[idx] / 2 };
+	const int centerY{ pY[idx] + pHeight[idx] / 2 };
+	const int halfWidth{ pWidth[idx] / 2 };
+	const int halfHeight{ pHeight[idx] / 2 };
+
+	// Loop over all the rooms
+	for (int j{ firstIdx }; j < nrRooms; ++j)
+	{
+		if (idx == j) continue;
+
+		// Distance between the rooms
+		const int roomDistX{ abs(centerX - (pX[j] + pWidth[j] / 2)) };
+		const int roomDistY{ abs(centerY - (pY[j] + pHeight[j] / 2)) };
+
+		// The amount of space needed between buildings to have the minimal corridor
+		const int minCorridorSizeSpaceX{ halfWidth + pWidth[j] / 2 + minCorridorSize };
+		const int minCorridorSizeSpaceY{ halfHeight + pHeight[j] / 2 + minCorridorSize };
+
+		// Get which kind of corridor will be created
+		const bool isCorridorFlat{ roomDistX > roomDistY };
+
+		// If the rooms are too close to each other depending on which corridor will be created
+		if ((isCorridorFlat && roomDistX < minCorridorSizeSpaceX) || (!isCorridorFlat && roomDistY < minCorridorSizeSpaceY)) return true;
+	}
+
+	return false;
+}
+
+#ifdef ROOM_KERNEL_X86
+ROOM_KERNEL_TARGET("sse4.1")
+bool RoomKernel::AddSeperationDirectionSSE41(const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction)
+{
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// The bounds and the center of the current room, in every lane
+	const __m128i minX{ _mm_set1_epi32(pX[idx]) };
+	const __m128i minY{ _mm_set1_epi32(pY[idx]) };
+	const __m128i maxX{ _mm_set1_epi32(pX[idx] + pWidth[idx]) };
+	const __m128i maxY{ _mm_set1_epi32(pY[idx] + pHeight[idx]) };
+	const __m128i centerX{ _mm_set1_epi32(pX[idx] + pWidth[idx] / 2) };
+	const __m128i centerY{ _mm_set1_epi32(pY[idx] + pHeight[idx] / 2) };
+	const __m128i roomIdx{ _mm_set1_epi32(idx) };
+
+	const __m128 half{ _mm_set1_ps(0.5f) };
+	const __m128 signBit{ _mm_set1_ps(-0.0f) };
+	const __m128 zero{ _mm_setzero_ps() };
+
+	// The sum of the directions and whether any room overlaps, per lane
+	__m128i directionX{ _mm_setzero_si128() };
+	__m128i directionY{ _mm_setzero_si128() };
+	__m128i isOverlapping{ _mm_setzero_si128() };
+
+	// Test 4 rooms at once
+	int j{};
+	for (; j + 4 <= nrRooms; j += 4)
+	{
+		const __m128i x{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pX + j)) };
+		const __m128i y{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pY + j)) };
+		const __m128i width{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWidth + j)) };
+		const __m128i height{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pHeight + j)) };
+
+		// The same overlap test as the scalar code, skipping the room itself
+		const __m128i otherIdx{ _mm_add_epi32(_mm_set1_epi32(j), _mm_setr_epi32(0, 1, 2, 3)) };
+		__m128i overlap{ _mm_cmpgt_epi32(_mm_add_epi32(x, width), minX) };
+		overlap = _mm_and_si128(overlap, _mm_cmpgt_epi32(maxX, x));
+		overlap = _mm_and_si128(overlap, _mm_cmpgt_epi32(maxY, y));
+		overlap = _mm_and_si128(overlap, _mm_cmpgt_epi32(_mm_add_epi32(y, height), minY));
+		overlap = _mm_andnot_si128(_mm_cmpeq_epi32(otherIdx, roomIdx), overlap);
+
+		// If none of the rooms overlap, continue to the next rooms
+		if (_mm_testz_si128(overlap, overlap)) continue;
+
+		isOverlapping = _mm_or_si128(isOverlapping, overlap);
+
+		// Calculate the direction between the rooms, halving rounds towards zero like an integer division
+		const __m128i halfWidth{ _mm_srai_epi32(_mm_add_epi32(width, _mm_srli_epi32(width, 31)), 1) };
+		const __m128i halfHeight{ _mm_srai_epi32(_mm_add_epi32(height, _mm_srli_epi32(height, 31)), 1) };
+		const __m128i curDirectionX{ _mm_sub_epi32(centerX, _mm_add_epi32(x, halfWidth)) };
+		const __m128i curDirectionY{ _mm_sub_epi32(centerY, _mm_add_epi32(y, halfHeight)) };
+
+		// Normalize the direction, with the same float operations as Vector2::ToDirection
+		const __m128i lengthSqr{ _mm_add_epi32(_mm_mullo_epi32(curDirectionX, curDirectionX), _mm_mullo_epi32(curDirectionY, curDirectionY)) };
+		const __m128 length{ _mm_sqrt_ps(_mm_cvtepi32_ps(lengthSqr)) };
+		const __m128 rangedX{ _mm_div_ps(_mm_cvtepi32_ps(curDirectionX), length) };
+		const __m128 rangedY{ _mm_div_ps(_mm_cvtepi32_ps(curDirectionY), length) };
+
+		// Each component becomes 1 if its absolute value is greater than 0.5 and gets the sign of the component
+		const __m128i isLongX{ _mm_srli_epi32(_mm_castps_si128(_mm_cmpgt_ps(_mm_andnot_ps(signBit, rangedX), half)), 31) };
+		const __m128i isLongY{ _mm_srli_epi32(_mm_castps_si128(_mm_cmpgt_ps(_mm_andnot_ps(signBit, rangedY), half)), 31) };
+		const __m128i isNegativeX{ _mm_castps_si128(_mm_cmplt_ps(rangedX, zero)) };
+		const __m128i isNegativeY{ _mm_castps_si128(_mm_cmplt_ps(rangedY, zero)) };
+		const __m128i normalizedY{ _mm_sub_epi32(_mm_xor_si128(isLongY, isNegativeY), isNegativeY) };
+
+		// Rooms with the same center are pushed apart horizontally like the scalar code, -1 if the other room has a higher index and 1 otherwise
+		const __m128i isSameCenter{ _mm_and_si128(_mm_cmpeq_epi32(curDirectionX, _mm_setzero_si128()), _mm_cmpeq_epi32(curDirectionY, _mm_setzero_si128())) };
+		const __m128i sameCenterX{ _mm_or_si128(_mm_cmpgt_epi32(otherIdx, roomIdx), _mm_set1_epi32(1)) };
+		const __m128i normalizedX{ _mm_blendv_epi8(_mm_sub_epi32(_mm_xor_si128(isLongX, isNegativeX), isNegativeX), sameCenterX, isSameCenter) };
+
+		// Only add the directions of overlapping rooms
+		directionX = _mm_add_epi32(directionX, _mm_and_si128(normalizedX, overlap));
+		directionY = _mm_add_epi32(directionY, _mm_and_si128(normalizedY, overlap));
+	}
+
+	// Add the directions of every lane, the sum of the directions times the max speed is equal to the sum of the directions at max speed
+	alignas(16) int laneDirectionX[4]{};
+	alignas(16) int laneDirectionY[4]{};
+	_mm_store_si128(reinterpret_cast<__m128i*>(laneDirectionX), directionX);
+	_mm_store_si128(reinterpret_cast<__m128i*>(laneDirectionY), directionY);
+
+	Vector2 curDirection{};
+	for (int lane{}; lane < 4; ++lane)
+	{
+		curDirection.x += laneDirectionX[lane];
+		curDirection.y += laneDirectionY[lane];
+	}
+	direction += curDirection * maxSpeed;
+
+	// Test the rooms that are left one by one
+	const bool isLastOverlapping{ AddSeperationDirectionScalar(rooms, idx, j, maxSpeed, direction) };
+
+	return !_mm_testz_si128(isOverlapping, isOverlapping) || isLastOverlapping;
+}
+
+ROOM_KERNEL_TARGET("avx2")
+bool RoomKernel::AddSeperationDirectionAVX2(const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction)
+{
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// The bounds and the center of the current room, in every lane
+	const __m256i minX{ _mm256_set1_epi32(pX[idx]) };
+	const __m256i minY{ _mm256_set1_epi32(pY[idx]) };
+	const __m256i maxX{ _mm256_set1_epi32(pX[idx] + pWidth[idx]) };
+	const __m256i maxY{ _mm256_set1_epi32(pY[idx] + pHeight[idx]) };
+	const __m256i centerX{ _mm256_set1_epi32(pX[idx] + pWidth[idx] / 2) };
+	const __m256i centerY{ _mm256_set1_epi32(pY[idx] + pHeight[idx] / 2) };
+	const __m256i roomIdx{ _mm256_set1_epi32(idx) };
+
+	const __m256 half{ _mm256_set1_ps(0.5f) };
+	const __m256 signBit{ _mm256_set1_ps(-0.0f) };
+	const __m256 zero{ _mm256_setzero_ps() };
+
+	// The sum of the directions and whether any room overlaps, per lane
+	__m256i directionX{ _mm256_setzero_si256() };
+	__m256i directionY{ _mm256_setzero_si256() };
+	__m256i isOverlapping{ _mm256_setzero_si256() };
+
+	// Test 8 rooms at once
+	int j{};
+	for (; j + 8 <= nrRooms; j += 8)
+	{
+		const __m256i x{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pX + j)) };
+		const __m256i y{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pY + j)) };
+		const __m256i width{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWidth + j)) };
+		const __m256i height{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pHeight + j)) };
+
+		// The same overlap test as the scalar code, skipping the room itself
+		const __m256i otherIdx{ _mm256_add_epi32(_mm256_set1_epi32(j), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)) };
+		__m256i overlap{ _mm256_cmpgt_epi32(_mm256_add_epi32(x, width), minX) };
+		overlap = _mm256_and_si256(overlap, _mm256_cmpgt_epi32(maxX, x));
+		overlap = _mm256_and_si256(overlap, _mm256_cmpgt_epi32(maxY, y));
+		overlap = _mm256_and_si256(overlap, _mm256_cmpgt_epi32(_mm256_add_epi32(y, height), minY));
+		overlap = _mm256_andnot_si256(_mm256_cmpeq_epi32(otherIdx, roomIdx), overlap);
+
+		// If none of the rooms overlap, continue to the next rooms
+		if (_mm256_testz_si256(overlap, overlap)) continue;
+
+		isOverlapping = _mm256_or_si256(isOverlapping, overlap);
+
+		// Calculate the direction between the rooms, halving rounds towards zero like an integer division
+		const __m256i halfWidth{ _mm256_srai_epi32(_mm256_add_epi32(width, _mm256_srli_epi32(width, 31)), 1) };
+		const __m256i halfHeight{ _mm256_srai_epi32(_mm256_add_epi32(height, _mm256_srli_epi32(height, 31)), 1) };
+		const __m256i curDirectionX{ _mm256_sub_epi32(centerX, _mm256_add_epi32(x, halfWidth)) };
+		const __m256i curDirectionY{ _mm256_sub_epi32(centerY, _mm256_add_epi32(y, halfHeight)) };
+
+		// Normalize the direction, with the same float operations as Vector2::ToDirection
+		const __m256i lengthSqr{ _mm256_add_epi32(_mm256_mullo_epi32(curDirectionX, curDirectionX), _mm256_mullo_epi32(curDirectionY, curDirectionY)) };
+		const __m256 length{ _mm256_sqrt_ps(_mm256_cvtepi32_ps(lengthSqr)) };
+		const __m256 rangedX{ _mm256_div_ps(_mm256_cvtepi32_ps(curDirectionX), length) };
+		const __m256 rangedY{ _mm256_div_ps(_mm256_cvtepi32_ps(curDirectionY), length) };
+
+		// Each component becomes 1 if its absolute value is greater than 0.5 and gets the sign of the component
+		const __m256i isLongX{ _mm256_srli_epi32(_mm256_castps_si256(_mm256_cmp_ps(_mm256_andnot_ps(signBit, rangedX), half, _CMP_GT_OQ)), 31) };
+		const __m256i isLongY{ _mm256_srli_epi32(_mm256_castps_si256(_mm256_cmp_ps(_mm256_andnot_ps(signBit, rangedY), half, _CMP_GT_OQ)), 31) };
+		const __m256i isNegativeX{ _mm256_castps_si256(_mm256_cmp_ps(rangedX, zero, _CMP_LT_OQ)) };
+		const __m256i isNegativeY{ _mm256_castps_si256(_mm256_cmp_ps(rangedY, zero, _CMP_LT_OQ)) };
+		const __m256i normalizedY{ _mm256_sub_epi32(_mm256_xor_si256(isLongY, isNegativeY), isNegativeY) };
+
+		// Rooms with the same center are pushed apart horizontally like the scalar code, -1 if the other room has a higher index and 1 otherwise
+		const __m256i isSameCenter{ _mm256_and_si256(_mm256_cmpeq_epi32(curDirectionX, _mm256_setzero_si256()), _mm256_cmpeq_epi32(curDirectionY, _mm256_setzero_si256())) };
+		const __m256i sameCenterX{ _mm256_or_si256(_mm256_cmpgt_epi32(otherIdx, roomIdx), _mm256_set1_epi32(1)) };
+		const __m256i normalizedX{ _mm256_blendv_epi8(_mm256_sub_epi32(_mm256_xor_si256(isLongX, isNegativeX), isNegativeX), sameCenterX, isSameCenter) };
+
+		// Only add the directions of overlapping rooms
+		directionX = _mm256_add_epi32(directionX, _mm256_and_si256(normalizedX, overlap));
+		directionY = _mm256_add_epi32(directionY, _mm256_and_si256(normalizedY, overlap));
+	}
+
+	// Add the directions of every lane, the sum of the directions times the max speed is equal to the sum of the directions at max speed
+	alignas(32) int laneDirectionX[8]{};
+	alignas(32) int laneDirectionY[8]{};
+	_mm256_store_si256(reinterpret_cast<__m256i*>(laneDirectionX), directionX);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(laneDirectionY), directionY);
+
+	Vector2 curDirection{};
+	for (int lane{}; lane < 8; ++lane)
+	{
+		curDirection.x += laneDirectionX[lane];
+		curDirection.y += laneDirectionY[lane];
+	}
+	direction += curDirection * maxSpeed;
+
+	// Test the rooms that are left one by one
+	const bool isLastOverlapping{ AddSeperationDirectionScalar(rooms, idx, j, maxSpeed, direction) };
+
+	return !_mm256_testz_si256(isOverlapping, isOverlapping) || isLastOverlapping;
+}
+
+ROOM_KERNEL_TARGET("sse4.1")
+bool RoomKernel::IsBorderingSSE41(const RoomStore& rooms, int idx, int minCorridorSize)
+{
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// The center and the half size of the current room plus the minimal corridor size, in every lane
+	const __m128i centerX{ _mm_set1_epi32(pX[idx] + pWidth[idx] / 2) };
+	const __m128i centerY{ _mm_set1_epi32(pY[idx] + pHeight[idx] / 2) };
+	const __m128i minSpaceX{ _mm_set1_epi32(pWidth[idx] / 2 + minCorridorSize) };
+	const __m128i minSpaceY{ _mm_set1_epi32(pHeight[idx] / 2 + minCorridorSize) };
+	const __m128i roomIdx{ _mm_set1_epi32(idx) };
+
+	// Test 4 rooms at once
+	int j{};
+	for (; j + 4 <= nrRooms; j += 4)
+	{
+		const __m128i width{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWidth + j)) };
+		const __m128i height{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(pHeight + j)) };
+		const __m128i halfWidth{ _mm_srai_epi32(_mm_add_epi32(width, _mm_srli_epi32(width, 31)), 1) };
+		const __m128i halfHeight{ _mm_srai_epi32(_mm_add_epi32(height, _mm_srli_epi32(height, 31)), 1) };
+
+		// Distance between the rooms
+		const __m128i otherCenterX{ _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pX + j)), halfWidth) };
+		const __m128i otherCenterY{ _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pY + j)), halfHeight) };
+		const __m128i roomDistX{ _mm_abs_epi32(_mm_sub_epi32(centerX, otherCenterX)) };
+		const __m128i roomDistY{ _mm_abs_epi32(_mm_sub_epi32(centerY, otherCenterY)) };
+
+		// The amount of space needed between buildings to have the minimal corridor
+		const __m128i minCorridorSizeSpaceX{ _mm_add_epi32(minSpaceX, halfWidth) };
+		const __m128i minCorridorSizeSpaceY{ _mm_add_epi32(minSpaceY, halfHeight) };
+
+		// If the rooms are too close to each other depending on which corridor will be created, skipping the room itself
+		const __m128i isCorridorFlat{ _mm_cmpgt_epi32(roomDistX, roomDistY) };
+		__m128i isTooClose{ _mm_or_si128(
+			_mm_and_si128(isCorridorFlat, _mm_cmpgt_epi32(minCorridorSizeSpaceX, roomDistX)),
+			_mm_andnot_si128(isCorridorFlat, _mm_cmpgt_epi32(minCorridorSizeSpaceY, roomDistY))) };
+		isTooClose = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_add_epi32(_mm_set1_epi32(j), _mm_setr_epi32(0, 1, 2, 3)), roomIdx), isTooClose);
+
+		if (!_mm_testz_si128(isTooClose, isTooClose)) return true;
+	}
+
+	// Test the rooms that are left one by one
+	return IsBorderingScalar(rooms, idx, j, minCorridorSize);
+}
+
+ROOM_KERNEL_TARGET("avx2")
+bool RoomKernel::IsBorderingAVX2(const RoomStore& rooms, int idx, int minCorridorSize)
+{
+	// The geometry of every room
+	const int nrRooms{ rooms.GetCount() };
+	const int* pX{ rooms.GetX() };
+	const int* pY{ rooms.GetY() };
+	const int* pWidth{ rooms.GetWidth() };
+	const int* pHeight{ rooms.GetHeight() };
+
+	// The center and the half size of the current room plus the minimal corridor size, in every lane
+	const __m256i centerX{ _mm256_set1_epi32(pX[idx] + pWidth[idx] / 2) };
+	const __m256i centerY{ _mm256_set1_epi32(pY[idx] + pHeight[idx] / 2) };
+	const __m256i minSpaceX{ _mm256_set1_epi32(pWidth[idx] / 2 + minCorridorSize) };
+	const __m256i minSpaceY{ _mm256_set1_epi32(pHeight[idx] / 2 + minCorridorSize) };
+	const __m256i roomIdx{ _mm256_set1_epi32(idx) };
+
+	// Test 8 rooms at once
+	int j{};
+	for (; j + 8 <= nrRooms; j += 8)
+	{
+		const __m256i width{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWidth + j)) };
+		const __m256i height{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pHeight + j)) };
+		const __m256i halfWidth{ _mm256_srai_epi32(_mm256_add_epi32(width, _mm256_srli_epi32(width, 31)), 1) };
+		const __m256i halfHeight{ _mm256_srai_epi32(_mm256_add_epi32(height, _mm256_srli_epi32(height, 31)), 1) };
+
+		// Distance between the rooms
+		const __m256i otherCenterX{ _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pX + j)), halfWidth) };
+		const __m256i otherCenterY{ _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pY + j)), halfHeight) };
+		const __m256i roomDistX{ _mm256_abs_epi32(_mm256_sub_epi32(centerX, otherCenterX)) };
+		const __m256i roomDistY{ _mm256_abs_epi32(_mm256_sub_epi32(centerY, otherCenterY)) };
+
+		// The amount of space needed between buildings to have the minimal corridor
+		const __m256i minCorridorSizeSpaceX{ _mm256_add_epi32(minSpaceX, halfWidth) };
+		const __m256i minCorridorSizeSpaceY{ _mm256_add_epi32(minSpaceY, halfHeight) };
+
+		// If the rooms are too close to each other depending on which corridor will be created, skipping the room itself
+		const __m256i isCorridorFlat{ _mm256_cmpgt_epi32(roomDistX, roomDistY) };
+		__m256i isTooClose{ _mm256_or_si256(
+			_mm256_and_si256(isCorridorFlat, _mm256_cmpgt_epi32(minCorridorSizeSpaceX, roomDistX)),
+			_mm256_andnot_si256(isCorridorFlat, _mm256_cmpgt_epi32(minCorridorSizeSpaceY, roomDistY))) };
+		isTooClose = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_add_epi32(_mm256_set1_epi32(j), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)), roomIdx), isTooClose);
+
+		if (!_mm256_testz_si256(isTooClose, isTooClose)) return true;
+	}
+
+	// Test the rooms that are left one by one
+	return IsBorderingScalar(rooms, idx, j, minCorridorSize);
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include "RoomStore.h"
+
+//-----------------------------------------------------
+// RoomKernel Class
+//-----------------------------------------------------
+// Tests one room against every other room in a store, using the widest instruction set the processor supports
+// Every instruction set gives the exact same result as the scalar code
+class RoomKernel final
+{
+public:
+	enum class InstructionSet
+	{
+		Scalar,
+		SSE41,
+		AVX2
+	};
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	static InstructionSet GetSupportedInstructionSet();
+	static InstructionSet ClampInstructionSet(InstructionSet instructionSet);
+	static const char* GetInstructionSetName(InstructionSet instructionSet);
+
+	// Adds the seperation direction away from every room that overlaps with the room, returns whether any room overlaps
+	static bool AddSeperationDirection(InstructionSet instructionSet, const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction);
+
+	// Returns whether any room is too close to the room to fit a corridor of the minimal size in between
+	static bool IsBordering(InstructionSet instructionSet, const RoomStore& rooms, int idx, int minCorridorSize);
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	static bool AddSeperationDirectionScalar(const RoomStore& rooms, int idx, int firstIdx, int maxSpeed, Vector2& direction);
+	static bool AddSeperationDirectionSSE41(const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction);
+	static bool AddSeperationDirectionAVX2(const RoomStore& rooms, int idx, int maxSpeed, Vector2& direction);
+
+	static bool IsBorderingScalar(const RoomStore& rooms, int idx, int firstIdx, int minCorridorSize);
+	static bool IsBorderingSSE41(const RoomStore& rooms, int idx, int minCorridorSize);
+	static bool IsBorderingAVX2(const RoomStore& rooms, int idx, int minCorridorSize);
+};
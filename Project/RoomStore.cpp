@@ -0,0 +1,71 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "RoomStore.h"
+
+//---------------------------
+// Member functions
+//---------------------------
+void RoomStore::Clear()
+{
+	m_X.clear();
+	m_Y.clear();
+	m_Width.clear();
+	m_Height.clear();
+}
+
+void RoomStore::Add(const Vector2& position, const Vector2& size)
+{
+	m_X.push_back(position.x);
+	m_Y.push_back(position.y);
+	m_Width.push_back(size.x);
+	m_Height.push_back(size.y);
+}
+
+void RoomStore::RemoveRooms(const std::vector<bool>& isRemoved)
+{
+	// Move every room that is kept to the first free index
+	int nrKeptRooms{};
+	for (int i{}; i < GetCount(); ++i)
+	{
+		if (isRemoved[i]) continue;
+
+		m_X[nrKeptRooms] = m_X[i];
+		m_Y[nrKeptRooms] = m_Y[i];
+		m_Width[nrKeptRooms] = m_Width[i];
+		m_Height[nrKeptRooms] = m_Height[i];
+		++nrKeptRooms;
+	}
+
+	m_X.resize(nrKeptRooms);
+	m_Y.resize(nrKeptRooms);
+	m_Width.resize(nrKeptRooms);
+	m_Height.resize(nrKeptRooms);
+}
+
+void RoomStore::Move(int idx, const Vector2& direction)
+{
+	m_X[idx] += direction.x;
+	m_Y[idx] += direction.y;
+}
+
+bool RoomStore::IsOverlapping(int idx, int otherIdx) const
+{
+	return m_X[idx] < m_X[otherIdx] + m_Width[otherIdx] && m_X[idx] + m_Width[idx] > m_X[otherIdx] &&
+		m_Y[idx] + m_Height[idx] > m_Y[otherIdx] && m_Y[idx] < m_Y[otherIdx] + m_Height[otherIdx];
+}
+
+DungeonRoom RoomStore::CreateRoom(int idx, const Color& color) const
+{
+	return DungeonRoom{ GetPosition(idx), GetSize(idx), color };
+}
+
+void RoomStore::CreateRooms(std::vector<DungeonRoom>& rooms, const Color& color) const
+{
+	// Replace the rooms by the rooms in this store
+	rooms.clear();
+	for (int i{}; i < GetCount(); ++i)
+	{
+		rooms.push_back(CreateRoom(i, color));
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <vector>
+#include "DungeonRoom.h"
+
+//-----------------------------------------------------
+// RoomStore Class
+//-----------------------------------------------------
+// Stores the geometry of the rooms as seperate arrays, the generation stages only touch the coordinates they need
+class RoomStore final
+{
+public:
+	RoomStore() = default;		// Constructor
+	~RoomStore() = default;		// Destructor
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	void Clear();
+	void Add(const Vector2& position, const Vector2& size);
+	// Removes every marked room in one pass, the rooms that are left keep their order
+	void RemoveRooms(const std::vector<bool>& isRemoved);
+	void Move(int idx, const Vector2& direction);
+
+	int GetCount() const { return static_cast<int>(m_X.size()); }
+	bool IsEmpty() const { return m_X.empty(); }
+	Vector2 GetPosition(int idx) const { return Vector2{ m_X[idx], m_Y[idx] }; }
+	Vector2 GetSize(int idx) const { return Vector2{ m_Width[idx], m_Height[idx] }; }
+	Vector2 GetCenter(int idx) const { return GetPosition(idx) + GetSize(idx) / 2; }
+	bool IsOverlapping(int idx, int otherIdx) const;
+
+	const int* GetX() const { return m_X.data(); }
+	const int* GetY() const { return m_Y.data(); }
+	const int* GetWidth() const { return m_Width.data(); }
+	const int* GetHeight() const { return m_Height.data(); }
+
+	DungeonRoom CreateRoom(int idx, const Color& color) const;
+	void CreateRooms(std::vector<DungeonRoom>& rooms, const Color& color) const;
+
+private:
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	std::vector<int> m_X{};
+	std::vector<int> m_Y{};
+	std::vector<int> m_Width{};
+	std::vector<int> m_Height{};
+};
@@ -2,6 +2,7 @@
 #include "Dungeon.h"
 #include "GameDefines.h"
 #include "Camera.h"
+#include "Profiler.h"
 
 SlowDungeonSolver::SlowDungeonSolver(std::shared_ptr<Dungeon> dungeon)
 	: DungeonSolver{ dungeon }
@@ -10,19 +11,18 @@ SlowDungeonSolver::SlowDungeonSolver(std::shared_ptr<Dungeon> dungeon)
 
 bool SlowDungeonSolver::Solve(bool saveShortestRoute)
 {
+	PROFILE_COUNT(SolveCalls, 1);
+
 	// Reset the previous rooms and discovered rooms
-	m_PreviousRooms = std::stack<int>();
-	m_DiscoveredRooms.clear();
-	m_TotalPath.clear();
-	m_NrKeys = 0;
-	m_ForcedPath.clear();
+	ResetSolve();
 
 	// Set the current room to the start room
 	m_CurRoom = m_pDungeon->GetStartRoom();
 
-	m_IsActive = true;
+	// A dungeon without a start or an end room can't be solved, the solver stays inactive
+	m_IsActive = m_CurRoom >= 0 && m_pDungeon->GetEndRoom() >= 0;
 
-	return true;
+	return m_IsActive;
 }
 
 void SlowDungeonSolver::Update(float elapsedSec)
@@ -0,0 +1,157 @@
+//---------------------------
+// Includes
+//---------------------------
+#include "SpatialHashGrid.h"
+#include <algorithm>
+
+//---------------------------
+// Member functions
+//---------------------------
+void SpatialHashGrid::Clear()
+{
+	// Empty every cell but keep the cells allocated, so the grid can be refilled without reallocating
+	for (auto& cell : m_Cells)
+	{
+		cell.second.clear();
+	}
+}
+
+void SpatialHashGrid::SetCellSize(int cellSize)
+{
+	// Changing the size of a cell invalidates every cell
+	if (cellSize != m_CellSize) m_Cells.clear();
+
+	m_CellSize = cellSize > 0 ? cellSize : 1;
+}
+
+void SpatialHashGrid::Insert(int idx, const Vector2& position, const Vector2& size)
+{
+	const CellRange range{ GetCellRange(position, size) };
+
+	// Add the index to every cell the rect covers
+	for (int cellX{ range.minX }; cellX <= range.maxX; ++cellX)
+	{
+		for (int cellY{ range.minY }; cellY <= range.maxY; ++cellY)
+		{
+			m_Cells[GetCellKey(cellX, cellY)].push_back(idx);
+		}
+	}
+}
+
+void SpatialHashGrid::Move(int idx, const Vector2& oldPosition, const Vector2& newPosition, const Vector2& size)
+{
+	// If the rect still covers the same cells, nothing has to change
+	if (GetCellRange(oldPosition, size) == GetCellRange(newPosition, size)) return;
+
+	Remove(idx, oldPosition, size);
+	Insert(idx, newPosition, size);
+}
+
+void SpatialHashGrid::Query(const Vector2& position, const Vector2& size, std::vector<int>& result)
+{
+	result.clear();
+
+	// Start a new query
+	++m_CurQueryStamp;
+
+	const CellRange range{ GetCellRange(position, size) };
+
+	// A rect that covers more cells than there are cells in the grid only looks at the cells in the grid, most of the cells it covers are empty
+	if (GetNrCells(position, size) > static_cast<long long>(m_Cells.size()))
+	{
+		for (const auto& cell : m_Cells)
+		{
+			const int cellX{ static_cast<int>(cell.first >> 32) };
+			const int cellY{ static_cast<int>(static_cast<unsigned int>(cell.first)) };
+			if (cellX < range.minX || cellX > range.maxX || cellY < range.minY || cellY > range.maxY) continue;
+
+			AddQueryResult(cell.second, result);
+		}
+
+		// The cells of the grid are in no particular order, sorting keeps the result the same on every platform
+		std::sort(result.begin(), result.end());
+		return;
+	}
+
+	// Collect every index in the cells the rect covers
+	for (int cellX{ range.minX }; cellX <= range.maxX; ++cellX)
+	{
+		for (int cellY{ range.minY }; cellY <= range.maxY; ++cellY)
+		{
+			const auto cellIt{ m_Cells.find(GetCellKey(cellX, cellY)) };
+			if (cellIt == m_Cells.end()) continue;
+
+			AddQueryResult(cellIt->second, result);
+		}
+	}
+}
+
+long long SpatialHashGrid::GetNrCells(const Vector2& position, const Vector2& size) const
+{
+	const CellRange range{ GetCellRange(position, size) };
+	return (static_cast<long long>(range.maxX) - range.minX + 1) * (static_cast<long long>(range.maxY) - range.minY + 1);
+}
+
+void SpatialHashGrid::Remove(int idx, const Vector2& position, const Vector2& size)
+{
+	const CellRange range{ GetCellRange(position, size) };
+
+	// Remove the index from every cell the rect covers
+	for (int cellX{ range.minX }; cellX <= range.maxX; ++cellX)
+	{
+		for (int cellY{ range.minY }; cellY <= range.maxY; ++cellY)
+		{
+			const auto cellIt{ m_Cells.find(GetCellKey(cellX, cellY)) };
+			if (cellIt == m_Cells.end()) continue;
+
+			std::vector<int>& cell{ cellIt->second };
+			for (size_t i{}; i < cell.size(); ++i)
+			{
+				if (cell[i] != idx) continue;
+
+				// Swap with the last index, the order inside a cell is irrelevant
+				cell[i] = cell[cell.size() - 1];
+				cell.pop_back();
+				break;
+			}
+		}
+	}
+}
+
+void SpatialHashGrid::AddQueryResult(const std::vector<int>& cell, std::vector<int>& result)
+{
+	for (int idx : cell)
+	{
+		// Grow the stamps container if this index has never been seen
+		if (idx >= static_cast<int>(m_QueryStamps.size())) m_QueryStamps.resize(idx + 1);
+
+		// If this index has already been added during this query, continue to the next index
+		if (m_QueryStamps[idx] == m_CurQueryStamp) continue;
+
+		m_QueryStamps[idx] = m_CurQueryStamp;
+		result.push_back(idx);
+	}
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::GetCellRange(const Vector2& position, const Vector2& size) const
+{
+	// Rects are half open, the last covered coordinate is position + size - 1
+	return CellRange
+	{
+		ToCell(position.x),
+		ToCell(position.y),
+		ToCell(position.x + max(size.x, 1) - 1),
+		ToCell(position.y + max(size.y, 1) - 1)
+	};
+}
+
+int SpatialHashGrid::ToCell(int coordinate) const
+{
+	// Floor division, so negative coordinates end up in the correct cell
+	return coordinate >= 0 ? coordinate / m_CellSize : -((-coordinate + m_CellSize - 1) / m_CellSize);
+}
+
+long long SpatialHashGrid::GetCellKey(int cellX, int cellY)
+{
+	return (static_cast<long long>(cellX) << 32) ^ static_cast<unsigned int>(cellY);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+//-----------------------------------------------------
+// Include Files
+//-----------------------------------------------------
+#include <vector>
+#include <unordered_map>
+#include "DataTypes.h"
+
+//-----------------------------------------------------
+// SpatialHashGrid Class
+//-----------------------------------------------------
+class SpatialHashGrid final
+{
+public:
+	SpatialHashGrid() = default;		// Constructor
+	~SpatialHashGrid() = default;		// Destructor
+
+	//-------------------------------------------------
+	// Member functions
+	//-------------------------------------------------
+	void Clear();
+	void SetCellSize(int cellSize);
+
+	void Insert(int idx, const Vector2& position, const Vector2& size);
+	void Move(int idx, const Vector2& oldPosition, const Vector2& newPosition, const Vector2& size);
+	void Query(const Vector2& position, const Vector2& size, std::vector<int>& result);
+
+	// The amount of cells a rect covers, also the amount of cells a query of this rect looks at when the grid has more cells
+	long long GetNrCells(const Vector2& position, const Vector2& size) const;
+
+private:
+	//-------------------------------------------------
+	// Private member functions
+	//-------------------------------------------------
+	struct CellRange
+	{
+		int minX{}, minY{}, maxX{}, maxY{};
+
+		bool operator==(const CellRange& other) const
+		{
+			return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+		}
+	};
+
+	// Only Move removes indices, the grid is cleared as a whole otherwise
+	void Remove(int idx, const Vector2& position, const Vector2& size);
+	CellRange GetCellRange(const Vector2& position, const Vector2& size) const;
+	int ToCell(int coordinate) const;
+	void AddQueryResult(const std::vector<int>& cell, std::vector<int>& result);
+	static long long GetCellKey(int cellX, int cellY);
+
+	//-------------------------------------------------
+	// Datamembers
+	//-------------------------------------------------
+	int m_CellSize{ 64 };
+
+	std::unordered_map<long long, std::vector<int>> m_Cells{};
+
+	// Query stamps, makes sure an index that spans multiple cells is only returned once
+	std::vector<int> m_QueryStamps{};
+	int m_CurQueryStamp{};
+};
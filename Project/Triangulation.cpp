@@ -2,14 +2,28 @@
 // Includes
 //---------------------------
 #include "Triangulation.h"
+#ifndef DUNGEON_HEADLESS
 #include "Camera.h"
+#endif
+#include <algorithm>
 
 //---------------------------
 // Member functions
 //---------------------------
+#ifndef DUNGEON_HEADLESS
 void Triangulation::Draw() const
 {
-	GAME_ENGINE->SetColor(RGB(0, 255, 0));
+	std::vector<POINT> lines{};
+	lines.reserve(m_Triangles.size() * 6);
+
+	// Skip edges that are off screen or that fall within one pixel
+	const auto addLine{ [&lines](const Vector2& p0, const Vector2& p1)
+		{
+			if (p0 == p1 || !CAMERA->IsLineOnScreen(p0, p1)) return;
+
+			lines.push_back(POINT{ p0.x, p0.y });
+			lines.push_back(POINT{ p1.x, p1.y });
+		} };
 
 	// For each triangle
 	for (const Triangle& triangle : m_Triangles)
@@ -19,15 +33,23 @@ void Triangulation::Draw() const
 		const Vector2& v1{ CAMERA->ScalePoint(m_Vertices[triangle.second].first) };
 		const Vector2& v2{ CAMERA->ScalePoint(m_Vertices[triangle.third].first) };
 
-		// Draw each edge
-		GAME_ENGINE->DrawLine(v0.x, v0.y, v1.x, v1.y);
-		GAME_ENGINE->DrawLine(v1.x, v1.y, v2.x, v2.y);
-		GAME_ENGINE->DrawLine(v2.x, v2.y, v0.x, v0.y);
+		// Add each edge
+		addLine(v0, v1);
+		addLine(v1, v2);
+		addLine(v2, v0);
 	}
+
+	// Draw every edge in one call
+	GAME_ENGINE->SetColor(RGB(0, 255, 0));
+	GAME_ENGINE->DrawLines(lines.data(), static_cast<int>(lines.size() / 2));
 }
+#endif
 
-void Triangulation::CreateSetOfEdges(std::set<Edge>& edges) const
+void Triangulation::CreateListOfEdges(std::vector<Edge>& edges) const
 {
+	edges.clear();
+	edges.reserve(m_Triangles.size() * 3);
+
 	// For each triangle
 	for (const Triangle& triangle : m_Triangles)
 	{
@@ -60,10 +82,26 @@ void Triangulation::CreateSetOfEdges(std::set<Edge>& edges) const
 			}
 			}
 
-			// Add the new edge to the set
-			edges.insert(newEdge);
+			// Add the new edge to the list
+			edges.push_back(newEdge);
 		}
 	}
+
+	// Sort the edges by length, a stable sort keeps the first occurence of an edge in front of its duplicates
+	std::stable_sort(edges.begin(), edges.end());
+
+	// Remove the duplicate edges (edges shared by two triangles), only the first occurence is kept
+	edges.erase(
+		std::unique(
+			edges.begin(),
+			edges.end(),
+			[](const Edge& edge0, const Edge& edge1)
+			{
+				return !(edge0 < edge1) && !(edge1 < edge0);
+			}
+		),
+		edges.end()
+	);
 }
 
 size_t Triangulation::GetSize() const
@@ -88,4 +126,6 @@ void Triangulation::RemoveTriangle(size_t index)
 {
 	m_Triangles[index] = m_Triangles[m_Triangles.size() - 1];
 	m_Triangles.pop_back();
+
+	if (m_pListener) m_pListener->OnGenerationEvent(GenerationEvent{ GenerationEventType::TriangleRemoved, static_cast<int>(index) });
 }
@@ -6,7 +6,7 @@
 #include <vector>
 #include "DataTypes.h"
 #include "DungeonRoom.h"
-#include <set>
+#include "GenerationListener.h"
 
 //-----------------------------------------------------
 // Triangulation Class									
@@ -21,9 +21,15 @@ public:
 	// Member functions						
 	//-------------------------------------------------
 	virtual void Triangulate(std::vector<DungeonRoom>& rooms) = 0;
+#ifndef DUNGEON_HEADLESS
 	void Draw() const;
-	void CreateSetOfEdges(std::set<Edge>& edges) const;
+#endif
+	void CreateListOfEdges(std::vector<Edge>& edges) const;
 	virtual size_t GetSize() const;
+	// Rooms that all lie on one line have no triangles, and without triangles they can't be connected
+	size_t GetNrTriangles() const { return m_Triangles.size(); }
+	// Reports every triangle that is set or removed to the listener, nullptr stops reporting
+	void SetListener(GenerationListener* pListener) { m_pListener = pListener; }
 protected:
 	//-------------------------------------------------
 	// Private member functions								
@@ -37,5 +43,7 @@ protected:
 	//-------------------------------------------------
 	std::vector<Triangle> m_Triangles{};
 	std::vector<std::pair<Vector2, int>> m_Vertices{};
+
+	GenerationListener* m_pListener{};
 };
 
@@ -1,12 +1,70 @@
 #pragma once
-#include <stdlib.h>
+#include <stdint.h>
 
-inline float RandomFloat(float min, float max)
+//-----------------------------------------------------
+// RandomGenerator Class
+//-----------------------------------------------------
+// Small PCG32 random number generator, every generator owns its own state so dungeons can be generated on multiple threads
+// It only uses integer math, the same seed gives the same numbers on every platform
+class RandomGenerator final
 {
-	return (rand() % 1001 / 1000.0f) * (max - min) + min;
-}
+public:
+	explicit RandomGenerator(uint64_t seed = 0)
+	{
+		SetSeed(seed);
+	}
 
-inline int RandomInt(int min, int max)
-{
-	return rand() % (max - min + 1) + min;
-}
\ No newline at end of file
+	void SetSeed(uint64_t seed)
+	{
+		m_State = 0;
+		Next();
+		m_State += seed;
+		Next();
+	}
+
+	// Mixes a seed with a stream index (SplitMix64), every stream gives unrelated numbers but is still reproducable from the seed
+	static uint64_t DeriveSeed(uint64_t seed, uint64_t stream)
+	{
+		uint64_t z{ seed + (stream + 1) * 0x9E3779B97F4A7C15ULL };
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	// The whole state of the generator, restoring it repeats the same numbers
+	uint64_t GetState() const { return m_State; }
+	void SetState(uint64_t state) { m_State = state; }
+
+	uint32_t Next()
+	{
+		const uint64_t oldState{ m_State };
+		m_State = oldState * 6364136223846793005ULL + m_Increment;
+
+		// Permute the old state into the output
+		const uint32_t xorShifted{ static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u) };
+		const uint32_t rotation{ static_cast<uint32_t>(oldState >> 59u) };
+		return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+	}
+
+	float RandomFloat(float min, float max)
+	{
+		return (Next() % 1001 / 1000.0f) * (max - min) + min;
+	}
+
+	int RandomInt(int min, int max)
+	{
+		return static_cast<int>(Next() % static_cast<uint32_t>(max - min + 1)) + min;
+	}
+
+	// For ranges that don't fit in an int, uses 64 random bits so ranges up to 2^32 are still uniform
+	long long RandomLongLong(long long min, long long max)
+	{
+		const uint64_t high{ Next() };
+		const uint64_t low{ Next() };
+		return static_cast<long long>(((high << 32) | low) % (static_cast<uint64_t>(max - min) + 1)) + min;
+	}
+
+private:
+	uint64_t m_State{};
+	static constexpr uint64_t m_Increment{ 1442695040888963407ULL };
+};